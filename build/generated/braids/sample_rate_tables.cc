@@ -0,0 +1,482 @@
+// Sample-rate dependent lookup tables.
+//
+// Automatically generated with:
+// scripts/gen_tables.py --sample-rate 44100
+
+#include "braids/sample_rate_tables.h"
+
+namespace braids {
+
+const uint16_t lut_resonator_coefficient[] = {
+   65535,  65535,  65535,  65535,
+   65535,  65535,  65535,  65535,
+   65535,  65535,  65535,  65535,
+   65535,  65535,  65535,  65534,
+   65534,  65534,  65534,  65534,
+   65534,  65533,  65533,  65533,
+   65533,  65532,  65532,  65531,
+   65531,  65530,  65530,  65529,
+   65528,  65527,  65526,  65525,
+   65524,  65523,  65521,  65519,
+   65517,  65515,  65513,  65510,
+   65507,  65503,  65499,  65495,
+   65490,  65484,  65478,  65471,
+   65463,  65454,  65444,  65433,
+   65421,  65407,  65391,  65373,
+   65353,  65331,  65306,  65278,
+   65247,  65211,  65172,  65127,
+   65077,  65021,  64958,  64888,
+   64808,  64720,  64620,  64508,
+   64383,  64242,  64084,  63907,
+   63708,  63486,  63236,  62957,
+   62643,  62292,  61898,  61458,
+   60964,  60412,  59794,  59102,
+   58329,  57465,  56500,  55423,
+   54221,  52882,  51391,  49732,
+   47888,  45842,  43574,  41065,
+   38295,  35241,  31885,  28206,
+   24186,  19808,  15062,   9942,
+    4449,      0,      0,      0,
+       0,      0,      0,      0,
+       0,      0,      0,      0,
+       0,      0,      0,      0,
+       0,
+};
+const uint16_t lut_resonator_scale[] = {
+       1,      1,      1,      1,
+       1,      2,      2,      2,
+       2,      2,      2,      3,
+       3,      3,      4,      4,
+       4,      5,      5,      5,
+       6,      6,      7,      8,
+       8,      9,     10,     11,
+      12,     13,     14,     15,
+      17,     18,     20,     22,
+      24,     26,     28,     31,
+      33,     36,     40,     43,
+      47,     51,     56,     61,
+      67,     73,     79,     86,
+      94,    103,    112,    122,
+     133,    145,    159,    173,
+     188,    206,    224,    244,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,    256,    256,    256,
+     256,
+};
+const uint16_t lut_svf_cutoff[] = {
+      38,     40,     42,     45,
+      48,     50,     53,     57,
+      60,     64,     68,     72,
+      76,     80,     85,     90,
+      96,    101,    107,    114,
+     121,    128,    136,    144,
+     152,    161,    171,    181,
+     192,    203,    215,    228,
+     242,    256,    272,    288,
+     305,    323,    342,    363,
+     384,    407,    431,    457,
+     484,    513,    544,    576,
+     610,    647,    685,    726,
+     769,    815,    863,    914,
+     969,   1027,   1088,   1152,
+    1221,   1293,   1370,   1452,
+    1538,   1630,   1727,   1829,
+    1938,   2053,   2175,   2305,
+    2442,   2587,   2741,   2904,
+    3076,   3259,   3453,   3658,
+    3875,   4105,   4349,   4607,
+    4881,   5170,   5477,   5802,
+    6146,   6510,   6896,   7304,
+    7737,   8195,   8679,   9192,
+    9735,  10309,  10916,  11559,
+   12238,  12957,  13716,  14518,
+   15366,  16261,  17206,  18202,
+   19254,  20361,  21528,  22755,
+   24046,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,  25078,  25078,  25078,
+   25078,
+};
+const uint16_t lut_granular_envelope_rate[] = {
+    4458,   4506,   4555,   4605,
+    4655,   4706,   4757,   4809,
+    4861,   4914,   4968,   5022,
+    5076,   5132,   5188,   5244,
+    5301,   5359,   5417,   5476,
+    5536,   5596,   5657,   5719,
+    5781,   5844,   5908,   5972,
+    6037,   6103,   6169,   6236,
+    6304,   6373,   6442,   6513,
+    6584,   6655,   6728,   6801,
+    6875,   6950,   7026,   7102,
+    7179,   7258,   7337,   7417,
+    7497,   7579,   7662,   7745,
+    7829,   7915,   8001,   8088,
+    8176,   8265,   8355,   8446,
+    8538,   8631,   8725,   8820,
+    8916,   9013,   9111,   9210,
+    9311,   9412,   9515,   9618,
+    9723,   9829,   9936,  10044,
+   10153,  10264,  10376,  10489,
+   10603,  10718,  10835,  10953,
+   11072,  11193,  11315,  11438,
+   11563,  11689,  11816,  11945,
+   12075,  12206,  12339,  12473,
+   12609,  12747,  12885,  13026,
+   13168,  13311,  13456,  13602,
+   13751,  13900,  14052,  14205,
+   14359,  14516,  14674,  14834,
+   14995,  15158,  15324,  15490,
+   15659,  15830,  16002,  16176,
+   16352,  16530,  16710,  16892,
+   17076,  17262,  17450,  17640,
+   17832,  18027,  18223,  18421,
+   18622,  18825,  19030,  19237,
+   19446,  19658,  19872,  20089,
+   20307,  20529,  20752,  20978,
+   21207,  21437,  21671,  21907,
+   22145,  22387,  22630,  22877,
+   23126,  23378,  23632,  23890,
+   24150,  24413,  24679,  24947,
+   25219,  25494,  25771,  26052,
+   26336,  26622,  26912,  27205,
+   27502,  27801,  28104,  28410,
+   28719,  29032,  29348,  29668,
+   29991,  30317,  30648,  30981,
+   31319,  31660,  32004,  32353,
+   32705,  33061,  33421,  33785,
+   34153,  34525,  34901,  35281,
+   35665,  36054,  36446,  36843,
+   37244,  37650,  38060,  38474,
+   38893,  39317,  39745,  40178,
+   40615,  41058,  41505,  41957,
+   42414,  42875,  43342,  43814,
+   44291,  44774,  45261,  45754,
+   46252,  46756,  47265,  47780,
+   48300,  48826,  49358,  49895,
+   50439,  50988,  51543,  52104,
+   52672,  53245,  53825,  54411,
+   55004,  55603,  56208,  56820,
+   57439,  58064,  58697,  59336,
+   59982,  60635,  61296,  61963,
+   62638,  63320,  64009,  64706,
+   65411,  65535,  65535,  65535,
+   65535,  65535,  65535,  65535,
+   65535,
+};
+const uint16_t lut_flute_body_filter[] = {
+      66,     70,     74,     78,
+      83,     88,     93,     99,
+     105,    111,    118,    125,
+     132,    140,    148,    157,
+     166,    176,    187,    198,
+     210,    222,    236,    250,
+     265,    280,    297,    315,
+     333,    353,    374,    397,
+     420,    445,    472,    500,
+     530,    561,    595,    630,
+     667,    707,    749,    794,
+     841,    891,    944,   1000,
+    1060,   1123,   1190,   1260,
+    1335,   1415,   1499,   1588,
+    1683,   1783,   1889,   2001,
+    2120,   2246,   2380,   2521,
+    2671,   2830,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+    2867,   2867,   2867,   2867,
+};
+const uint16_t lut_bowing_envelope[] = {
+       0,     23,     47,     71,
+      95,    119,    142,    166,
+     190,    214,    238,    262,
+     285,    309,    333,    357,
+     381,    405,    428,    452,
+     476,    500,    524,    548,
+     571,    595,    619,    643,
+     667,    691,    714,    738,
+     762,    786,    810,    834,
+     857,    881,    905,    929,
+     953,    977,   1000,   1024,
+    1048,   1072,   1096,   1120,
+    1143,   1167,   1191,   1215,
+    1239,   1263,   1286,   1310,
+    1334,   1358,   1382,   1406,
+    1429,   1453,   1477,   1501,
+    1525,   1549,   1572,   1596,
+    1620,   1644,   1668,   1692,
+    1715,   1739,   1763,   1787,
+    1811,   1835,   1858,   1882,
+    1906,   1930,   1954,   1977,
+    2001,   2025,   2049,   2073,
+    2097,   2120,   2144,   2168,
+    2192,   2216,   2240,   2263,
+    2287,   2311,   2335,   2359,
+    2383,   2406,   2430,   2454,
+    2478,   2502,   2526,   2549,
+    2573,   2597,   2621,   2645,
+    2669,   2692,   2716,   2740,
+    2764,   2788,   2812,   2835,
+    2859,   2883,   2907,   2931,
+    2955,   2978,   3002,   3026,
+    3050,   3074,   3098,   3121,
+    3145,   3169,   3193,   3217,
+    3241,   3264,   3288,   3312,
+    3336,   3360,   3384,   3407,
+    3431,   3455,   3479,   3503,
+    3527,   3550,   3574,   3598,
+    3622,   3646,   3670,   3693,
+    3717,   3741,   3765,   3789,
+    3813,   3836,   3860,   3884,
+    3908,   3932,   3955,   3979,
+    4003,   4027,   4051,   4075,
+    4098,   4122,   4146,   4170,
+    4194,   4218,   4241,   4265,
+    4289,   4313,   4337,   4361,
+    4384,   4408,   4432,   4456,
+    4480,   4504,   4527,   4551,
+    4575,   4599,   4623,   4647,
+    4670,   4694,   4718,   4742,
+    4766,   4790,   4813,   4837,
+    4861,   4885,   4909,   4933,
+    4956,   4980,   5004,   5028,
+    5052,   5076,   5099,   5123,
+    5147,   5171,   5195,   5219,
+    5242,   5266,   5290,   5314,
+    5338,   5362,   5385,   5409,
+    5433,   5457,   5481,   5505,
+    5528,   5552,   5576,   5600,
+    5624,   5648,   5671,   5695,
+    5719,   5743,   5767,   5790,
+    5814,   5838,   5862,   5886,
+    5910,   5933,   5957,   5981,
+    6005,   6029,   6053,   6076,
+    6100,   6124,   6148,   6172,
+    6196,   6219,   6243,   6267,
+    6291,   6315,   6339,   6362,
+    6386,   6410,   6434,   6458,
+    6482,   6505,   6529,   6553,
+    6553,   6529,   6505,   6480,
+    6456,   6432,   6407,   6383,
+    6359,   6335,   6310,   6286,
+    6262,   6238,   6213,   6189,
+    6165,   6140,   6116,   6092,
+    6068,   6043,   6019,   5995,
+    5971,   5946,   5922,   5898,
+    5873,   5849,   5825,   5801,
+    5776,   5752,   5728,   5704,
+    5679,   5655,   5631,   5606,
+    5582,   5558,   5534,   5509,
+    5485,   5461,   5437,   5412,
+    5388,   5364,   5339,   5315,
+    5291,   5267,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,   5242,
+    5242,   5242,   5242,
+};
+const uint16_t lut_blowing_envelope[] = {
+       0,    394,    788,   1183,
+    1577,   1972,   2366,   2761,
+    3155,   3549,   3944,   4338,
+    4733,   5127,   5522,   5916,
+    6310,   6705,   7099,   7494,
+    7888,   8283,   8677,   9071,
+    9466,   9860,  10255,  10649,
+   11044,  11438,  11832,  12227,
+   12621,  13016,  13410,  13805,
+   14199,  14593,  14988,  15382,
+   15777,  16171,  16566,  16960,
+   17354,  17749,  18143,  18538,
+   18932,  19327,  19721,  20115,
+   20510,  20904,  21299,  21299,
+   21260,  21221,  21181,  21142,
+   21103,  21064,  21025,  20986,
+   20947,  20908,  20869,  20830,
+   20791,  20752,  20712,  20673,
+   20634,  20595,  20556,  20517,
+   20478,  20439,  20400,  20361,
+   20322,  20283,  20244,  20204,
+   20165,  20126,  20087,  20048,
+   20009,  19970,  19931,  19892,
+   19853,  19814,  19775,  19735,
+   19696,  19657,  19618,  19579,
+   19540,  19501,  19462,  19423,
+   19384,  19345,  19306,  19266,
+   19227,  19188,  19149,  19110,
+   19071,  19032,  18993,  18954,
+   18915,  18876,  18837,  18798,
+   18758,  18719,  18680,  18641,
+   18602,  18563,  18524,  18485,
+   18446,  18407,  18368,  18329,
+   18289,  18250,  18211,  18172,
+   18133,  18094,  18055,  18016,
+   17977,  17938,  17899,  17860,
+   17820,  17781,  17742,  17703,
+   17664,  17625,  17586,  17547,
+   17508,  17469,  17430,  17391,
+   17352,  17312,  17273,  17234,
+   17195,  17156,  17117,  17078,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,  17039,  17039,  17039,
+   17039,
+};
+const uint32_t lut_oscillator_increments[] = {
+  1294309365, 1303688464, 1313135528, 1322651049,
+  1332235524, 1341889452, 1351613336, 1361407683,
+  1371273005, 1381209814, 1391218630, 1401299974,
+  1411454371, 1421682351, 1431984447, 1442361197,
+  1452813141, 1463340824, 1473944795, 1484625606,
+  1495383815, 1506219983, 1517134674, 1528128457,
+  1539201906, 1550355597, 1561590113, 1572906039,
+  1584303964, 1595784484, 1607348196, 1618995704,
+  1630727614, 1642544538, 1654447093, 1666435899,
+  1678511580, 1690674767, 1702926093, 1715266198,
+  1727695724, 1740215319, 1752825637, 1765527334,
+  1778321073, 1791207520, 1804187348, 1817261234,
+  1830429858, 1843693907, 1857054073, 1870511052,
+  1884065547, 1897718262, 1911469911, 1925321210,
+  1939272881, 1953325652, 1967480255, 1981737428,
+  1996097914, 2010562462, 2025131827, 2039806767,
+  2054588047, 2069476439, 2084472719, 2099577667,
+  2114792073, 2130116728, 2145552432, 2161099989,
+  2176760210, 2192533912, 2208421917, 2224425052,
+  2240544153, 2256780060, 2273133618, 2289605682,
+  2306197108, 2322908763, 2339741518, 2356696249,
+  2373773842, 2390975185, 2408301177, 2425752720,
+  2443330725, 2461036106, 2478869788, 2496832701,
+  2514925780, 2533149969, 2551506217, 2569995483,
+  2588618730,
+};
+const uint32_t lut_oscillator_delays[] = {
+  890761927, 884353536, 877991250, 871674735,
+  865403664, 859177708, 852996543, 846859848,
+  840767301, 834718586, 828713388, 822751392,
+  816832288, 810955768, 805121526, 799329257,
+  793578659, 787869432, 782201279, 776573904,
+  770987015, 765440319, 759933527, 754466353,
+  749038511, 743649719, 738299695, 732988160,
+  727714839, 722479455, 717281735, 712121410,
+  706998210, 701911867, 696862117, 691848696,
+  686871343, 681929799, 677023805, 672153107,
+  667317449, 662516581, 657750251, 653018212,
+  648320217, 643656020, 639025379, 634428051,
+  629863799, 625332382, 620833566, 616367116,
+  611932799, 607530383, 603159640, 598820341,
+  594512260, 590235173, 585988856, 581773088,
+  577587650, 573432323, 569306891, 565211138,
+  561144851, 557107818, 553099829, 549120674,
+  545170146, 541248040, 537354150, 533488274,
+  529650210, 525839759, 522056720, 518300898,
+  514572097, 510870121, 507194779, 503545878,
+  499923228, 496326641, 492755928, 489210904,
+  485691384, 482197185, 478728123, 475284019,
+  471864693, 468469967, 465099663, 461753606,
+  458431622, 455133536, 451859178, 448608377,
+  445380963,
+};
+const uint32_t lut_env_portamento_increments[] = {
+  3116529557, 2631039058, 2232030949, 1902267286,
+  1628292750, 1399532288, 1207620439, 1045898830,
+  909036808, 792742966, 693544262, 608615813,
+  535648893, 472747983, 418349994, 371160577,
+  330103612, 294280983, 262940366, 235449338,
+  211274452, 189964286, 171135620, 154462151,
+  139665229, 126506223, 114780226, 104310820,
+  94945735, 86553219, 79019007, 72243767,
+  66140963, 60635038, 55659890, 51157566,
+  47077164, 43373884, 40008226, 36945302,
+  34154242, 31607684, 29281340, 27153608,
+  25205253, 23419116, 21779872, 20273808,
+  18888643, 17613359, 16438057, 15353837,
+  14352681, 13427362, 12571352, 11778753,
+  11044228, 10362940, 9730504, 9142938,
+  8596623, 8088265, 7614867, 7173694,
+  6762251, 6378259, 6019634, 5684471,
+  5371022, 5077687, 4802997, 4545603,
+  4304266, 4077845, 3865291, 3665637,
+  3477992, 3301533, 3135500, 2979192,
+  2831961, 2693205, 2562370, 2438940,
+  2322437, 2212419, 2108474, 2010221,
+  1917303, 1829392, 1746178, 1667378,
+  1592722, 1521964, 1454871, 1391226,
+  1330828, 1273487, 1219028, 1167285,
+  1118103, 1071338, 1026855, 984526,
+  944233, 905864, 869313, 834484,
+  801282, 769622, 739422, 710604,
+  683098, 656834, 631748, 607781,
+  584875, 562977, 542035, 522004,
+  502836, 484490, 466926, 450105,
+  433991, 418552, 403753, 389566,
+};
+
+}  // namespace braids
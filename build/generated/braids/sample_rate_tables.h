@@ -0,0 +1,41 @@
+// Sample-rate dependent lookup tables.
+//
+// Automatically generated with:
+// scripts/gen_tables.py --sample-rate 44100
+
+#ifndef BRAIDS_SAMPLE_RATE_TABLES_H_
+#define BRAIDS_SAMPLE_RATE_TABLES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace braids {
+
+const uint32_t kSampleRate = 44100;
+const size_t kDelayLineShift = 1;
+
+extern const uint16_t lut_resonator_coefficient[];
+extern const uint16_t lut_resonator_scale[];
+extern const uint16_t lut_svf_cutoff[];
+extern const uint16_t lut_granular_envelope_rate[];
+extern const uint16_t lut_flute_body_filter[];
+extern const uint16_t lut_bowing_envelope[];
+extern const uint16_t lut_blowing_envelope[];
+extern const uint32_t lut_oscillator_increments[];
+extern const uint32_t lut_oscillator_delays[];
+extern const uint32_t lut_env_portamento_increments[];
+
+}  // namespace braids
+
+#define LUT_RESONATOR_COEFFICIENT_SIZE 129
+#define LUT_RESONATOR_SCALE_SIZE 129
+#define LUT_SVF_CUTOFF_SIZE 257
+#define LUT_GRANULAR_ENVELOPE_RATE_SIZE 257
+#define LUT_FLUTE_BODY_FILTER_SIZE 128
+#define LUT_BOWING_ENVELOPE_SIZE 363
+#define LUT_BLOWING_ENVELOPE_SIZE 197
+#define LUT_OSCILLATOR_INCREMENTS_SIZE 97
+#define LUT_OSCILLATOR_DELAYS_SIZE 97
+#define LUT_ENV_PORTAMENTO_INCREMENTS_SIZE 128
+
+#endif  // BRAIDS_SAMPLE_RATE_TABLES_H_
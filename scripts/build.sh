@@ -47,9 +47,49 @@ echo "Cross prefix: $CROSS_PREFIX"
 mkdir -p build
 mkdir -p dist/braids
 
-# Compile Braids source files
+# Generate the sample-rate dependent lookup tables (default: Move's 44.1kHz)
+BRAIDS_SAMPLE_RATE="${BRAIDS_SAMPLE_RATE:-44100}"
+echo "Generating lookup tables for ${BRAIDS_SAMPLE_RATE} Hz..."
+python3 scripts/gen_tables.py --sample-rate "$BRAIDS_SAMPLE_RATE" --out build/generated
+
+# Table layout: "packed" re-emits resources.cc and the sample-rate tables as
+# one engine-grouped, cache-line aligned TU; "stock" links them as generated.
+# BRAIDS_TABLES_INT8=1 (packed only) adds 8-bit copies of the comb waveforms.
+BRAIDS_TABLE_LAYOUT="${BRAIDS_TABLE_LAYOUT:-packed}"
+BRAIDS_TABLES_INT8="${BRAIDS_TABLES_INT8:-0}"
+TABLE_DEFS=""
+if [ "$BRAIDS_TABLE_LAYOUT" = "packed" ]; then
+    PACK_ARGS="--drop-unused --scan src/dsp"
+    if [ "$BRAIDS_TABLES_INT8" = "1" ]; then
+        PACK_ARGS="$PACK_ARGS --int8 wav_bandlimited_comb_*"
+        TABLE_DEFS="-DBRAIDS_TABLES_INT8"
+    fi
+    echo "Packing lookup tables..."
+    python3 scripts/pack_tables.py $PACK_ARGS \
+        --input src/dsp/braids/resources.cc \
+        --input build/generated/braids/sample_rate_tables.cc \
+        --out build/generated/braids/resources_packed.cc \
+        --map build/resources_packed.map
+    TABLE_OBJS="build/resources_packed.o"
+elif [ "$BRAIDS_TABLE_LAYOUT" = "stock" ]; then
+    [ "$BRAIDS_TABLES_INT8" = "1" ] && \
+        { echo "BRAIDS_TABLES_INT8 needs BRAIDS_TABLE_LAYOUT=packed"; exit 1; }
+    TABLE_OBJS="build/resources.o build/sample_rate_tables.o"
+else
+    echo "Unknown BRAIDS_TABLE_LAYOUT: $BRAIDS_TABLE_LAYOUT"
+    exit 1
+fi
+
+# Compile the .braids presets into one mapped-in-place bank (presets.bank)
+echo "Packing presets..."
+python3 scripts/pack_presets.py --source src/dsp/braids_plugin.cpp \
+    --presets src/presets --out build/presets.bank
+
+# Compile Braids source files (both table layouts, so the benchmark can
+# compare them)
 echo "Compiling Braids DSP engine..."
 BRAIDS_SRCS="
+    build/generated/braids/sample_rate_tables.cc
     src/dsp/braids/macro_oscillator.cc
     src/dsp/braids/analog_oscillator.cc
     src/dsp/braids/digital_oscillator.cc
@@ -57,37 +97,124 @@ BRAIDS_SRCS="
     src/dsp/braids/quantizer.cc
     src/dsp/stmlib/utils/random.cc
 "
+[ "$BRAIDS_TABLE_LAYOUT" = "packed" ] && \
+    BRAIDS_SRCS="$BRAIDS_SRCS build/generated/braids/resources_packed.cc"
+
+# BRAIDS_ASAN=1 builds everything with AddressSanitizer (native builds only)
+# and, once linked, runs every engine through braids_bench at osc_block 64
+SANITIZE_FLAGS=""
+if [ "${BRAIDS_ASAN:-0}" = "1" ]; then
+    SANITIZE_FLAGS="-fsanitize=address -fno-omit-frame-pointer"
+fi
 
 for src in $BRAIDS_SRCS; do
     obj="build/$(basename "$src" .cc).o"
+    # The packed tables rely on definition order being kept
+    order=""
+    case "$src" in *resources_packed.cc) order="-fno-toplevel-reorder" ;; esac
     echo "  $src -> $obj"
-    ${CROSS_PREFIX}g++ -g -O3 -fPIC -std=c++14 \
-        -DTEST \
-        -Isrc/dsp \
+    ${CROSS_PREFIX}g++ $SANITIZE_FLAGS -g -O3 -fPIC -std=c++14 \
+        -DTEST $TABLE_DEFS $order \
+        -Isrc/dsp -Ibuild/generated \
         -c "$src" \
         -o "$obj"
 done
 
-# Compile plugin wrapper
+# Debug audio-path watchdog: BRAIDS_RT_WATCHDOG=1 routes the blocking calls
+# through rt_watchdog.h's wrappers (unfortified, so none bypass them)
+WATCHDOG_DEFS=""
+WATCHDOG_LDFLAGS=""
+if [ "${BRAIDS_RT_WATCHDOG:-0}" = "1" ]; then
+    WATCHDOG_DEFS="-DBRAIDS_RT_WATCHDOG=1 -U_FORTIFY_SOURCE"
+    for fn in malloc calloc realloc posix_memalign free open read write close \
+              fopen fread fwrite fclose pthread_mutex_lock pthread_cond_wait \
+              usleep nanosleep; do
+        WATCHDOG_LDFLAGS="$WATCHDOG_LDFLAGS -Wl,--wrap=$fn"
+    done
+fi
+
+# Compile plugin wrapper (BRAIDS_PERF_STATS=0 compiles out instrumentation)
 echo "Compiling plugin wrapper..."
-${CROSS_PREFIX}g++ -g -O3 -fPIC -std=c++14 \
-    -DTEST \
-    -Isrc/dsp \
+${CROSS_PREFIX}g++ $SANITIZE_FLAGS -g -O3 -fPIC -std=c++14 \
+    -DTEST $TABLE_DEFS $WATCHDOG_DEFS \
+    -DBRAIDS_PERF_STATS="${BRAIDS_PERF_STATS:-1}" \
+    -Isrc/dsp -Ibuild/generated \
     -c src/dsp/braids_plugin.cpp \
     -o build/braids_plugin.o
 
 # Link shared library
 echo "Linking dsp.so..."
-${CROSS_PREFIX}g++ -shared \
+${CROSS_PREFIX}g++ $SANITIZE_FLAGS -shared \
     build/braids_plugin.o \
     build/macro_oscillator.o \
     build/analog_oscillator.o \
     build/digital_oscillator.o \
-    build/resources.o \
+    $TABLE_OBJS \
     build/quantizer.o \
     build/random.o \
     -o build/dsp.so \
-    -lm
+    -lm -lpthread $WATCHDOG_LDFLAGS
+
+# Link host-less benchmark from the same objects (not packaged)
+echo "Linking braids_bench..."
+${CROSS_PREFIX}g++ $SANITIZE_FLAGS -g -O3 -std=c++14 \
+    -DTEST \
+    -Isrc/dsp -Ibuild/generated \
+    -c src/tools/braids_bench.cpp \
+    -o build/braids_bench.o
+${CROSS_PREFIX}g++ $SANITIZE_FLAGS \
+    build/braids_bench.o \
+    build/braids_plugin.o \
+    build/macro_oscillator.o \
+    build/analog_oscillator.o \
+    build/digital_oscillator.o \
+    $TABLE_OBJS \
+    build/quantizer.o \
+    build/random.o \
+    -o build/braids_bench \
+    -lm -lpthread $WATCHDOG_LDFLAGS
+
+if [ "${BRAIDS_ASAN:-0}" = "1" ]; then
+    echo "Running every engine under ASan (osc_block 64)..."
+    ASAN_OPTIONS="detect_leaks=0:halt_on_error=1" \
+        build/braids_bench --blocks 64 --voices 4 --set osc_block=64 > /dev/null
+fi
+
+# Offline MIDI file -> WAV renderer, same objects (not packaged)
+echo "Linking braids_render..."
+${CROSS_PREFIX}g++ $SANITIZE_FLAGS -g -O3 -std=c++14 \
+    -DTEST \
+    -Isrc/dsp -Ibuild/generated \
+    -c src/tools/braids_render.cpp \
+    -o build/braids_render.o
+${CROSS_PREFIX}g++ $SANITIZE_FLAGS \
+    build/braids_render.o \
+    build/braids_plugin.o \
+    build/macro_oscillator.o \
+    build/analog_oscillator.o \
+    build/digital_oscillator.o \
+    $TABLE_OBJS \
+    build/quantizer.o \
+    build/random.o \
+    -o build/braids_render \
+    -lm -lpthread $WATCHDOG_LDFLAGS
+
+# Same benchmark against the stock table layout, for --compare
+if [ "$BRAIDS_TABLE_LAYOUT" = "packed" ] && [ "$BRAIDS_TABLES_INT8" != "1" ]; then
+    echo "Linking braids_bench_stock..."
+    ${CROSS_PREFIX}g++ $SANITIZE_FLAGS \
+        build/braids_bench.o \
+        build/braids_plugin.o \
+        build/macro_oscillator.o \
+        build/analog_oscillator.o \
+        build/digital_oscillator.o \
+        build/resources.o \
+        build/sample_rate_tables.o \
+        build/quantizer.o \
+        build/random.o \
+        -o build/braids_bench_stock \
+        -lm -lpthread $WATCHDOG_LDFLAGS
+fi
 
 # Copy files to dist (use cat to avoid ExtFS deallocation issues with Docker)
 echo "Packaging..."
@@ -110,6 +237,8 @@ if [ -d "src/presets" ]; then
     for f in src/presets/*.braids; do
         [ -f "$f" ] && cat "$f" > "dist/braids/presets/$(basename "$f")"
     done
+    # After the files: the plugin ignores a bank older than any of them
+    cat build/presets.bank > dist/braids/presets.bank
 fi
 
 # Create tarball for release
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Generate Braids' sample-rate dependent lookup tables.
+
+The stock resources.cc is computed for the 96 kHz Braids firmware. Every
+table whose values depend on the sample rate (phase increments, delay
+lengths, filter coefficients, envelope and grain rates, excitation
+envelopes) is generated here for the target rate instead, and written to
+sample_rate_tables.h / sample_rate_tables.cc. With --sample-rate 96000 the
+output reproduces the stock tables (lut_resonator_scale to within 1 LSB).
+
+Usage:
+  gen_tables.py --out build/generated/braids [--sample-rate 44100]
+"""
+
+import argparse
+import math
+import os
+
+REFERENCE_SAMPLE_RATE = 96000.0
+EXCURSION = 65536 * 65536.0
+A4_MIDI = 69
+A4_PITCH = 440.0
+
+
+def linspace(start, stop, num):
+  if num == 1:
+    return [start]
+  step = (stop - start) / (num - 1)
+  return [start + i * step for i in range(num)]
+
+
+def note_frequency(note):
+  return A4_PITCH * 2 ** ((note - A4_MIDI) / 12.0)
+
+
+def clip(x, lo, hi):
+  return max(lo, min(hi, x))
+
+
+def make_tables(sample_rate):
+  tables_16 = []
+  tables_32 = []
+  ratio = REFERENCE_SAMPLE_RATE / sample_rate
+
+  # Phase increments and delays over the top octave (128ths of semitone,
+  # one entry every 16), from MIDI note 128 to 140.
+  notes = range(128 * 128, 140 * 128 + 16, 16)
+  pitches = [A4_PITCH * 2 ** ((n - A4_MIDI * 128) / (128 * 12.0))
+             for n in notes]
+  tables_32.append(('oscillator_increments',
+                    [int(EXCURSION / sample_rate * p) for p in pitches]))
+  tables_32.append(('oscillator_delays',
+                    [int(sample_rate / p * 65536 * 4096) for p in pitches]))
+
+  # Portamento / AD envelope increments, 3 samples to 0.25 s at 96 kHz.
+  gamma = 0.175
+  min_time = 3.0 / REFERENCE_SAMPLE_RATE
+  max_time = 0.25
+  rates = linspace((min_time * sample_rate) ** gamma,
+                   (max_time * sample_rate) ** gamma, 128)
+  tables_32.append(('env_portamento_increments',
+                    [int(clip(EXCURSION / r ** (1 / gamma), 0, 2 ** 32 - 1))
+                     for r in rates]))
+
+  # Two-pole resonators, one entry per semitone.
+  frequencies = [note_frequency(i) for i in range(129)]
+  tables_16.append(('resonator_coefficient',
+                    [int(clip(65536 * math.cos(4 * math.pi * f / sample_rate),
+                              0, 65535)) for f in frequencies]))
+  tables_16.append(('resonator_scale',
+                    [int(clip(round(
+                        128 * (f / note_frequency(A4_MIDI) * ratio) ** 1.5),
+                        1, 256)) for f in frequencies]))
+
+  # SVF cutoff, one entry per semitone (half-semitone resolution in the
+  # 8.24 interpolation), clamped to SR / 8.
+  frequencies = [note_frequency(i) for i in range(257)]
+  tables_16.append(('svf_cutoff',
+                    [int(2 * math.sin(math.pi * min(f / sample_rate, 1 / 8.0))
+                         * 32767) for f in frequencies]))
+
+  # Grain envelope phase increments (used << 3), 4 octaves of range.
+  tables_16.append(('granular_envelope_rate',
+                    [int(clip(2048 * 2 ** (i / 64.0) * ratio, 0, 65535))
+                     for i in range(257)]))
+
+  # Flute body one-pole coefficient, tracking pitch up to its stable limit.
+  tables_16.append(('flute_body_filter',
+                    [int(min(0.05 * 2 ** ((i - A4_MIDI) / 12.0) * ratio, 0.0875)
+                         * 32768) for i in range(128)]))
+
+  # Excitation envelopes: linear attack and decay to a sustain level, plus a
+  # 32-entry hold that the engines park on. The bow envelope is read at half
+  # rate.
+  def excitation(attack, peak, decay, sustain):
+    attack = max(2, int(round(attack / ratio)))
+    decay = max(2, int(round(decay / ratio)))
+    values = linspace(0, peak, attack) + linspace(peak, sustain, decay)
+    values += [sustain] * 32
+    return [int(v * 32768) for v in values]
+
+  tables_16.append(('bowing_envelope', excitation(600, 0.2, 120, 0.16)))
+  tables_16.append(('blowing_envelope', excitation(120, 0.65, 240, 0.52)))
+
+  return tables_16, tables_32
+
+
+def delay_line_shift(sample_rate):
+  # The delay lines are sized for 96 kHz; each halving of the rate halves
+  # them while keeping the lengths powers of two.
+  shift = 0
+  while REFERENCE_SAMPLE_RATE / (2 ** (shift + 1)) >= sample_rate:
+    shift += 1
+  return shift
+
+
+HEADER = """\
+// Sample-rate dependent lookup tables.
+//
+// Automatically generated with:
+// scripts/gen_tables.py --sample-rate %(sample_rate)d
+"""
+
+
+def format_values(values):
+  lines = []
+  for i in range(0, len(values), 4):
+    lines.append('  ' + ', '.join('%6d' % v for v in values[i:i + 4]) + ',')
+  return '\n'.join(lines)
+
+
+def write_header(path, sample_rate, tables_16, tables_32):
+  with open(path, 'w') as f:
+    f.write(HEADER % {'sample_rate': sample_rate})
+    f.write('\n#ifndef BRAIDS_SAMPLE_RATE_TABLES_H_\n')
+    f.write('#define BRAIDS_SAMPLE_RATE_TABLES_H_\n\n')
+    f.write('#include <stddef.h>\n#include <stdint.h>\n\n')
+    f.write('namespace braids {\n\n')
+    f.write('const uint32_t kSampleRate = %d;\n' % sample_rate)
+    f.write('const size_t kDelayLineShift = %d;\n\n' % delay_line_shift(sample_rate))
+    for name, _ in tables_16:
+      f.write('extern const uint16_t lut_%s[];\n' % name)
+    for name, _ in tables_32:
+      f.write('extern const uint32_t lut_%s[];\n' % name)
+    f.write('\n}  // namespace braids\n\n')
+    for name, values in tables_16 + tables_32:
+      f.write('#define LUT_%s_SIZE %d\n' % (name.upper(), len(values)))
+    f.write('\n#endif  // BRAIDS_SAMPLE_RATE_TABLES_H_\n')
+
+
+def write_source(path, sample_rate, tables_16, tables_32):
+  with open(path, 'w') as f:
+    f.write(HEADER % {'sample_rate': sample_rate})
+    f.write('\n#include "braids/sample_rate_tables.h"\n\n')
+    f.write('namespace braids {\n\n')
+    for type_name, tables in (('uint16_t', tables_16), ('uint32_t', tables_32)):
+      for name, values in tables:
+        f.write('const %s lut_%s[] = {\n' % (type_name, name))
+        f.write(format_values(values))
+        f.write('\n};\n')
+    f.write('\n}  // namespace braids\n')
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('--sample-rate', type=int, default=44100)
+  parser.add_argument('--out', required=True,
+                      help='directory receiving the braids/ table sources')
+  args = parser.parse_args()
+  if not 8000 <= args.sample_rate <= REFERENCE_SAMPLE_RATE:
+    parser.error('sample rate must be between 8000 and 96000 Hz')
+
+  tables_16, tables_32 = make_tables(float(args.sample_rate))
+  out_dir = os.path.join(args.out, 'braids')
+  os.makedirs(out_dir, exist_ok=True)
+  write_header(os.path.join(out_dir, 'sample_rate_tables.h'),
+               args.sample_rate, tables_16, tables_32)
+  write_source(os.path.join(out_dir, 'sample_rate_tables.cc'),
+               args.sample_rate, tables_16, tables_32)
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""Compile the .braids preset files into one binary preset bank.
+
+The plugin parses every presets/*.braids file when an instance first needs
+its library. With a presets.bank next to presets/, it maps that file instead
+and uses the records in place: one open, no parsing. The bank holds what the
+plugin's own parser would produce, so the layout, param order, defaults and
+engine names are read from braids_plugin.cpp rather than repeated here:
+
+  header      8 x uint32: magic "BRPB", version, count, param_count,
+              record_size, keys_offset, records_offset, 0
+  keys        param_count NUL-terminated keys, in BraidsParam order
+  records     count x BraidsPreset (char name[64], float params[N],
+              int32 octave_transpose), at records_offset (8-byte aligned)
+
+All little-endian. Files are taken in byte-wise name order, as the plugin
+sorts them; a file the plugin would skip (empty, over 4 KB) is skipped.
+
+Usage:
+  pack_presets.py --source src/dsp/braids_plugin.cpp --presets src/presets \\
+      --out build/presets.bank
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x42505242  # "BRPB"
+VERSION = 1         # PRESET_BANK_VERSION
+MAX_FILE_SIZE = 4096
+HEADER = struct.Struct('<8I')
+
+
+def strip_comments(text):
+  return re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+
+
+def block(source, pattern):
+  match = re.search(pattern + r'\s*\{(.*?)\};', source, re.S)
+  if not match:
+    sys.exit('pack_presets: %r not found in the plugin source' % pattern)
+  return match.group(1)
+
+
+def read_plugin(path):
+  """Param order, keys, defaults and engine names from braids_plugin.cpp."""
+  with open(path) as f:
+    text = f.read()
+  source = strip_comments(text)
+
+  params = re.findall(r'\b(PARAM_\w+)', block(source, r'enum BraidsParam'))
+  params = [p for p in params if p != 'PARAM_COUNT']
+  defaults = [float(v) for v in re.findall(
+      r'(-?\d+(?:\.\d+)?)f', block(source, r'g_param_defaults\[PARAM_COUNT\] ='))]
+  if len(defaults) != len(params):
+    sys.exit('pack_presets: %d defaults for %d params'
+             % (len(defaults), len(params)))
+
+  keys = {}
+  for key, param in re.findall(
+      r'\{"(\w+)",\s*"[^"]*",\s*PARAM_TYPE_\w+,\s*(PARAM_\w+)',
+      block(source, r'g_shadow_params\[\] =')):
+    keys[param] = key
+  missing = [p for p in params if p not in keys]
+  if missing:
+    sys.exit('pack_presets: no key for %s' % ', '.join(missing))
+
+  shapes = [re.sub(r'\\(.)', r'\1', s) for s in re.findall(
+      r'"((?:[^"\\]|\\.)*)"', block(source, r'g_shape_names\[\] ='))]
+  name_size = int(re.search(r'struct BraidsPreset\s*\{\s*char name\[(\d+)\]',
+                            source).group(1))
+  return [keys[p] for p in params], defaults, shapes, name_size
+
+
+def atof(value):
+  """C atof: the leading number of a string, 0 if there is none."""
+  if isinstance(value, bool):
+    return 0.0
+  if isinstance(value, (int, float)):
+    return float(value)
+  match = re.match(r'\s*[-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?', str(value))
+  return float(match.group(0)) if match else 0.0
+
+
+def compile_preset(data, index, keys, defaults, shapes, name_size):
+  """One BraidsPreset record, as parse_preset_json fills it."""
+  params = list(defaults)
+  name = 'Preset %d' % index
+  octave = 0
+  for key, value in data.items():
+    if key == 'name':
+      name = str(value)
+    elif key == 'engine':
+      if isinstance(value, str) and value in shapes:
+        engine = float(shapes.index(value))
+      else:
+        engine = min(max(atof(value), 0.0), float(len(shapes) - 1))
+      params[0] = engine
+    elif key == 'octave_transpose':
+      octave = min(max(int(atof(value)), -3), 3)
+    elif key in keys:
+      params[keys.index(key)] = atof(value)
+  raw_name = name.encode('utf-8')[:name_size - 1]
+  return struct.pack('<%ds%dfi' % (name_size, len(params)),
+                     raw_name, *params, octave)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('--source', required=True, help='braids_plugin.cpp')
+  parser.add_argument('--presets', required=True, help='.braids directory')
+  parser.add_argument('--out', required=True)
+  args = parser.parse_args()
+
+  keys, defaults, shapes, name_size = read_plugin(args.source)
+  if keys[0] != 'engine':
+    sys.exit('pack_presets: expected PARAM_ENGINE first')
+
+  names = sorted((n for n in os.listdir(args.presets)
+                  if len(n) > 7 and n.endswith('.braids')),
+                 key=lambda n: n.encode('utf-8'))
+  records = []
+  for name in names:
+    path = os.path.join(args.presets, name)
+    size = os.path.getsize(path)
+    if size == 0 or size > MAX_FILE_SIZE:
+      print('  skipping %s (%d bytes)' % (name, size))
+      continue
+    with open(path) as f:
+      try:
+        data = json.load(f)
+      except ValueError as e:
+        sys.exit('pack_presets: %s: %s' % (path, e))
+    records.append(compile_preset(data, len(records), keys, defaults, shapes,
+                                  name_size))
+
+  key_block = b''.join(k.encode('ascii') + b'\0' for k in keys)
+  keys_offset = HEADER.size
+  records_offset = (keys_offset + len(key_block) + 7) // 8 * 8
+  record_size = name_size + 4 * len(keys) + 4
+  header = HEADER.pack(MAGIC, VERSION, len(records), len(keys), record_size,
+                       keys_offset, records_offset, 0)
+  padding = b'\0' * (records_offset - keys_offset - len(key_block))
+
+  out_dir = os.path.dirname(args.out)
+  if out_dir:
+    os.makedirs(out_dir, exist_ok=True)
+  with open(args.out, 'wb') as f:
+    f.write(header + key_block + padding + b''.join(records))
+  print('Packed %d presets into %s' % (len(records), args.out))
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""Re-emit Braids' lookup tables in an engine-grouped, cache-aligned layout.
+
+resources.cc (and the generated sample_rate_tables.cc) list their tables in
+generator order, so an engine that reads several tables per sample touches
+pages far apart. This script parses those sources and writes a single
+resources_packed.cc that defines the same symbols, ordered so that the tables
+each engine uses sit next to each other, every table starting on a 64-byte
+cache line. The output is compiled with -fno-toplevel-reorder, which keeps
+the definition order in the object file.
+
+Options:
+  --drop-unused     leave out tables nothing in --scan references (directly
+                    or through a kept pointer table): the string/character
+                    tables, the lookup_table_*_table indexes, lut_vco_detune.
+  --int8 PATTERN    also emit 8-bit offset-binary copies (<name>_u8, the
+                    wt_waves format read by stmlib's uint8_t Interpolate824
+                    and Crossfade) of the int16 tables matching PATTERN, plus
+                    <pointer table>_u8 indexes over them, with NULL where a
+                    table was not converted. Copies whose SNR falls below
+                    --min-snr are skipped; the error of each is printed.
+  --min-snr DB      quality bar for --int8 copies (default 48 dB, about the
+                    level of Braids' own 8-bit wt_waves).
+  --map FILE        write the resulting layout (offset, size, group).
+
+Usage:
+  pack_tables.py --out build/generated/braids/resources_packed.cc \\
+      --input src/dsp/braids/resources.cc \\
+      --input build/generated/braids/sample_rate_tables.cc \\
+      [--scan src/dsp] [--drop-unused] [--int8 'wav_bandlimited_comb_*']
+"""
+
+import argparse
+import fnmatch
+import math
+import os
+import re
+import sys
+
+CACHE_LINE = 64
+
+# Tables each group of engines reads together, hottest groups first. Tables
+# not listed keep their generator order after the groups.
+GROUPS = [
+  ('oscillator core', [
+      'lut_oscillator_increments', 'lut_oscillator_delays',
+      'lut_fm_frequency_quantizer', 'wav_sine']),
+  ('svf', ['lut_svf_cutoff', 'lut_svf_damp', 'lut_svf_scale']),
+  ('waveshapers', [
+      'ws_moderate_overdrive', 'ws_violent_overdrive', 'ws_sine_fold',
+      'ws_tri_fold']),
+  ('buzz', ['waveform_table'] +
+      ['wav_bandlimited_comb_%d' % i for i in range(15)]),
+  ('vowel / vosim', ['wav_formant_sine', 'wav_formant_square', 'lut_bell']),
+  ('wavetables', ['wt_map', 'wt_code', 'wt_waves']),
+  ('physical models', [
+      'lut_resonator_coefficient', 'lut_resonator_scale',
+      'lut_bowing_envelope', 'lut_bowing_friction', 'lut_blowing_envelope',
+      'lut_blowing_jet', 'lut_flute_body_filter']),
+  ('granular', ['lut_granular_envelope', 'lut_granular_envelope_rate']),
+  ('envelopes', ['lut_env_expo', 'lut_env_portamento_increments']),
+]
+
+ELEMENT_SIZES = {
+  'char': 1, 'int8_t': 1, 'uint8_t': 1, 'int16_t': 2, 'uint16_t': 2,
+  'int32_t': 4, 'uint32_t': 4,
+}
+
+DEFINITION = re.compile(
+    r'^(static\s+)?const\s+(\w+)(\s*\*)?\s+(\w+)\[\]\s*=\s*'
+    r'(\{.*?\n\};|"[^"\n]*";)', re.M | re.S)
+
+HEADER = """\
+// Engine-grouped lookup tables.
+//
+// Automatically generated with:
+// scripts/pack_tables.py %(args)s
+//
+// Same symbols as resources.cc and sample_rate_tables.cc, reordered so that
+// each engine's tables are adjacent and cache-line aligned. Must be compiled
+// with -fno-toplevel-reorder to keep that order.
+"""
+
+
+class Table(object):
+
+  def __init__(self, match, source):
+    self.static = bool(match.group(1))
+    self.element = match.group(2)
+    self.pointer = bool(match.group(3))
+    self.name = match.group(4)
+    self.body = match.group(5)
+    self.source = source
+
+  @property
+  def entries(self):
+    return re.findall(r'-?\w+', self.body[1:-2]) if self.body[0] == '{' else []
+
+  @property
+  def values(self):
+    return [int(v) for v in self.entries]
+
+  @property
+  def size(self):
+    if self.pointer:
+      return 8 * len(self.entries)
+    if self.body[0] == '"':
+      return len(self.body) - 2
+    return ELEMENT_SIZES[self.element] * len(self.entries)
+
+  def declaration(self, aligned):
+    pointer = '*' if self.pointer else ''
+    attribute = ' __attribute__((aligned(%d)))' % CACHE_LINE if aligned else ''
+    return '%sconst %s%s %s[]%s = %s\n' % (
+        'static ' if self.static else '', self.element, pointer, self.name,
+        attribute, self.body)
+
+
+def parse_tables(paths):
+  tables = []
+  for path in paths:
+    with open(path) as f:
+      text = f.read()
+    tables.extend(Table(m, path) for m in DEFINITION.finditer(text))
+  return tables
+
+
+def referenced_identifiers(scan_dirs, inputs):
+  skip = set(os.path.abspath(p) for p in inputs)
+  words = set()
+  for scan_dir in scan_dirs:
+    for root, _, files in os.walk(scan_dir):
+      for name in files:
+        path = os.path.abspath(os.path.join(root, name))
+        if (path in skip or not name.endswith(('.cc', '.cpp', '.h')) or
+            name.startswith('resources.')):
+          continue
+        with open(path) as f:
+          words.update(re.findall(r'\w+', f.read()))
+  return words
+
+
+def drop_unused(tables, words):
+  by_name = dict((t.name, t) for t in tables)
+  keep = set(t.name for t in tables if t.name in words)
+  pending = list(keep)
+  while pending:
+    table = by_name[pending.pop()]
+    for entry in table.entries:
+      if entry in by_name and entry not in keep:
+        keep.add(entry)
+        pending.append(entry)
+  return [t for t in tables if t.name in keep]
+
+
+def order_tables(tables):
+  by_name = dict((t.name, t) for t in tables)
+  ordered = []
+  for group, names in GROUPS:
+    for name in names:
+      if name in by_name:
+        ordered.append((group, by_name.pop(name)))
+  ordered.extend(('other', t) for t in tables if t.name in by_name)
+  # Pointer tables reference their entries, so they need no particular
+  # position; the statics they may point at must come first, as in C++.
+  statics = [(g, t) for g, t in ordered if t.static]
+  return statics + [(g, t) for g, t in ordered if not t.static]
+
+
+def to_u8(values):
+  return [min(255, max(0, (v + 32768 + 128) >> 8)) for v in values]
+
+
+def u8_error(values, packed):
+  decoded = [(v << 8) - 32768 for v in packed]
+  error = [a - b for a, b in zip(values, decoded)]
+  signal = sum(v * v for v in values) / float(len(values))
+  noise = sum(e * e for e in error) / float(len(error))
+  snr = 10 * math.log10(signal / noise) if noise else float('inf')
+  return max(abs(e) for e in error), snr
+
+
+def format_values(values):
+  lines = []
+  for i in range(0, len(values), 8):
+    lines.append('  ' + ', '.join('%3d' % v for v in values[i:i + 8]) + ',')
+  return '\n'.join(lines)
+
+
+def int8_tables(tables, patterns, min_snr):
+  """Returns (definitions, report lines) for the --int8 copies."""
+  definitions = []
+  report = []
+  converted = set()
+  for table in tables:
+    if (table.pointer or table.element != 'int16_t' or
+        not any(fnmatch.fnmatch(table.name, p) for p in patterns)):
+      continue
+    packed = to_u8(table.values)
+    max_error, snr = u8_error(table.values, packed)
+    report.append('%-28s max error %5d LSB, SNR %5.1f dB%s' % (
+        table.name, max_error, snr, '' if snr >= min_snr else ', skipped'))
+    if snr < min_snr:
+      continue
+    definitions.append('const uint8_t %s_u8[] __attribute__((aligned(%d))) = '
+                       '{\n%s\n};\n' % (table.name, CACHE_LINE,
+                                        format_values(packed)))
+    converted.add(table.name)
+  for table in tables:
+    entries = table.entries
+    if not table.pointer or not converted.intersection(entries):
+      continue
+    lines = ['  %s,' % (e + '_u8' if e in converted else 'NULL')
+             for e in entries]
+    definitions.append('const uint8_t* %s_u8[] = {\n%s\n};\n' % (
+        table.name, '\n'.join(lines)))
+  return definitions, report
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('--input', action='append', required=True,
+                      help='table source (repeatable)')
+  parser.add_argument('--out', required=True)
+  parser.add_argument('--scan', action='append', default=[],
+                      help='source directory searched by --drop-unused')
+  parser.add_argument('--drop-unused', action='store_true')
+  parser.add_argument('--int8', action='append', default=[],
+                      metavar='PATTERN')
+  parser.add_argument('--min-snr', type=float, default=48.0, metavar='DB')
+  parser.add_argument('--map', help='write the table layout to this file')
+  args = parser.parse_args()
+
+  tables = parse_tables(args.input)
+  total = len(tables)
+  if args.drop_unused:
+    if not args.scan:
+      parser.error('--drop-unused needs at least one --scan directory')
+    tables = drop_unused(tables, referenced_identifiers(args.scan, args.input))
+  ordered = order_tables(tables)
+  extra, report = [], []
+  if args.int8:
+    extra, report = int8_tables(tables, args.int8, args.min_snr)
+
+  out_dir = os.path.dirname(args.out)
+  if out_dir:
+    os.makedirs(out_dir, exist_ok=True)
+  command = ' '.join(sys.argv[1:])
+  with open(args.out, 'w') as f:
+    f.write(HEADER % {'args': command})
+    f.write('\n#include "braids/resources.h"\n\nnamespace braids {\n\n')
+    group = None
+    for table_group, table in ordered:
+      if table_group != group:
+        f.write('// --- %s\n\n' % table_group)
+        group = table_group
+      f.write(table.declaration(not table.pointer and not table.static))
+      f.write('\n')
+    if extra:
+      f.write('// --- 8-bit copies (--int8)\n\n')
+      f.write('\n'.join(extra))
+    f.write('\n}  // namespace braids\n')
+
+  if args.map:
+    with open(args.map, 'w') as f:
+      offset = 0
+      for table_group, table in ordered:
+        if not table.pointer and not table.static:
+          offset = (offset + CACHE_LINE - 1) // CACHE_LINE * CACHE_LINE
+        f.write('%8d %7d  %-18s %s\n' % (offset, table.size, table_group,
+                                         table.name))
+        offset += table.size
+
+  print('Packed %d of %d tables into %s' % (len(tables), total, args.out))
+  for line in report:
+    print('  int8 ' + line)
+
+
+if __name__ == '__main__':
+  main()
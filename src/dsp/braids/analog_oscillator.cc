@@ -70,14 +70,17 @@ void AnalogOscillator::Render(
     int16_t* buffer,
     uint8_t* sync_out,
     size_t size) {
-  RenderFn fn = fn_table_[shape_];
+  RenderFn fn = sync_in ? fn_table_[shape_] : no_sync_fn_table_[shape_];
   
   if (shape_ != previous_shape_) {
     Init();
     previous_shape_ = shape_;
   }
   
-  phase_increment_ = ComputePhaseIncrement(pitch_);
+  if (pitch_ != increment_pitch_) {
+    phase_increment_ = ComputePhaseIncrement(pitch_);
+    increment_pitch_ = pitch_;
+  }
   
   if (pitch_ > kHighestNote) {
     pitch_ = kHighestNote;
@@ -88,6 +91,7 @@ void AnalogOscillator::Render(
   (this->*fn)(sync_in, buffer, sync_out, size);
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderCSaw(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -109,7 +113,7 @@ void AnalogOscillator::RenderCSaw(
     int32_t this_sample = next_sample;
     next_sample = 0;
 
-    if (*sync_in) {
+    if (kSync && *sync_in) {
       // sync_in contain the fractional reset time.
       reset_time = static_cast<uint32_t>(*sync_in - 1) << 9;
       uint32_t phase_at_reset = phase_ + \
@@ -128,7 +132,9 @@ void AnalogOscillator::RenderCSaw(
         next_sample += discontinuity * NextBlepSample(reset_time) >> 15;
       }
     }
-    sync_in++;
+    if (kSync) {
+      sync_in++;
+    }
 
     phase_ += phase_increment;
     if (phase_ < phase_increment) {
@@ -185,6 +191,7 @@ void AnalogOscillator::RenderCSaw(
   END_INTERPOLATE_PHASE_INCREMENT
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderSquare(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -208,7 +215,7 @@ void AnalogOscillator::RenderSquare(
     int32_t this_sample = next_sample;
     next_sample = 0;
     
-    if (*sync_in) {
+    if (kSync && *sync_in) {
       // sync_in contain the fractional reset time.
       reset_time = static_cast<uint32_t>(*sync_in - 1) << 9;
       uint32_t phase_at_reset = phase_ + \
@@ -222,7 +229,9 @@ void AnalogOscillator::RenderSquare(
         next_sample -= NextBlepSample(reset_time);
       }
     }
-    sync_in++;
+    if (kSync) {
+      sync_in++;
+    }
     
     phase_ += phase_increment;
     if (phase_ < phase_increment) {
@@ -271,6 +280,7 @@ void AnalogOscillator::RenderSquare(
   END_INTERPOLATE_PHASE_INCREMENT
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderSaw(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -288,7 +298,7 @@ void AnalogOscillator::RenderSaw(
     int32_t this_sample = next_sample;
     next_sample = 0;
 
-    if (*sync_in) {
+    if (kSync && *sync_in) {
       // sync_in contain the fractional reset time.
       reset_time = static_cast<uint32_t>(*sync_in - 1) << 9;
       uint32_t phase_at_reset = phase_ + \
@@ -301,7 +311,9 @@ void AnalogOscillator::RenderSaw(
       this_sample -= discontinuity * ThisBlepSample(reset_time) >> 15;
       next_sample -= discontinuity * NextBlepSample(reset_time) >> 15;
     }
-    sync_in++;
+    if (kSync) {
+      sync_in++;
+    }
 
     phase_ += phase_increment;
     if (phase_ < phase_increment) {
@@ -334,6 +346,7 @@ void AnalogOscillator::RenderSaw(
   END_INTERPOLATE_PHASE_INCREMENT
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderVariableSaw(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -356,7 +369,7 @@ void AnalogOscillator::RenderVariableSaw(
     int32_t this_sample = next_sample;
     next_sample = 0;
 
-    if (*sync_in) {
+    if (kSync && *sync_in) {
       // sync_in contain the fractional reset time.
       reset_time = static_cast<uint32_t>(*sync_in - 1) << 9;
       uint32_t phase_at_reset = phase_ + \
@@ -371,7 +384,9 @@ void AnalogOscillator::RenderVariableSaw(
       this_sample += discontinuity * ThisBlepSample(reset_time) >> 15;
       next_sample += discontinuity * NextBlepSample(reset_time) >> 15;
     }
-    sync_in++;
+    if (kSync) {
+      sync_in++;
+    }
 
     phase_ += phase_increment;
     if (phase_ < phase_increment) {
@@ -421,6 +436,7 @@ void AnalogOscillator::RenderVariableSaw(
   END_INTERPOLATE_PHASE_INCREMENT
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderTriangle(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -434,7 +450,7 @@ void AnalogOscillator::RenderTriangle(
     int16_t triangle;
     uint16_t phase_16;
     
-    if (*sync_in++) {
+    if (kSync && *sync_in++) {
       phase = 0;
     }
     
@@ -454,6 +470,7 @@ void AnalogOscillator::RenderTriangle(
   END_INTERPOLATE_PHASE_INCREMENT
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderSine(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -464,7 +481,7 @@ void AnalogOscillator::RenderSine(
   while (size--) {
     INTERPOLATE_PHASE_INCREMENT
     phase += phase_increment;
-    if (*sync_in++) {
+    if (kSync && *sync_in++) {
       phase = 0;
     }
     *buffer++ = Interpolate824(wav_sine, phase);
@@ -473,6 +490,7 @@ void AnalogOscillator::RenderSine(
   phase_ = phase;
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderTriangleFold(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -491,7 +509,7 @@ void AnalogOscillator::RenderTriangleFold(
     int16_t triangle;
     int16_t gain = 2048 + (parameter * 30720 >> 15);
     
-    if (*sync_in++) {
+    if (kSync && *sync_in++) {
       phase = 0;
     }
     
@@ -519,6 +537,7 @@ void AnalogOscillator::RenderTriangleFold(
   phase_ = phase;
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderSineFold(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -536,7 +555,7 @@ void AnalogOscillator::RenderSineFold(
     int16_t sine;
     int16_t gain = 2048 + (parameter * 30720 >> 15);
     
-    if (*sync_in++) {
+    if (kSync && *sync_in++) {
       phase = 0;
     }
     
@@ -560,6 +579,7 @@ void AnalogOscillator::RenderSineFold(
   phase_ = phase;
 }
 
+template<bool kSync>
 void AnalogOscillator::RenderBuzz(
     const uint8_t* sync_in,
     int16_t* buffer,
@@ -571,15 +591,30 @@ void AnalogOscillator::RenderBuzz(
   if (index >= kNumZones) {
     index = kNumZones - 1;
   }
-  const int16_t* wave_1 = waveform_table[WAV_BANDLIMITED_COMB_0 + index];
+  size_t wave_1_index = WAV_BANDLIMITED_COMB_0 + index;
+  const int16_t* wave_1 = waveform_table[wave_1_index];
   index += 1;
   if (index >= kNumZones) {
     index = kNumZones - 1;
   }
   const int16_t* wave_2 = waveform_table[WAV_BANDLIMITED_COMB_0 + index];
+#ifdef BRAIDS_TABLES_INT8
+  const uint8_t* wave_1_u8 = waveform_table_u8[wave_1_index];
+  const uint8_t* wave_2_u8 = waveform_table_u8[WAV_BANDLIMITED_COMB_0 + index];
+  if (wave_1_u8 && wave_2_u8) {
+    while (size--) {
+      phase_ += phase_increment_;
+      if (kSync && *sync_in++) {
+        phase_ = 0;
+      }
+      *buffer++ = Crossfade(wave_1_u8, wave_2_u8, phase_, crossfade);
+    }
+    return;
+  }
+#endif  // BRAIDS_TABLES_INT8
   while (size--) {
     phase_ += phase_increment_;
-    if (*sync_in++) {
+    if (kSync && *sync_in++) {
       phase_ = 0;
     }
     *buffer++ = Crossfade(wave_1, wave_2, phase_, crossfade);
@@ -588,15 +623,28 @@ void AnalogOscillator::RenderBuzz(
 
 /* static */
 AnalogOscillator::RenderFn AnalogOscillator::fn_table_[] = {
-  &AnalogOscillator::RenderSaw,
-  &AnalogOscillator::RenderVariableSaw,
-  &AnalogOscillator::RenderCSaw,
-  &AnalogOscillator::RenderSquare,
-  &AnalogOscillator::RenderTriangle,
-  &AnalogOscillator::RenderSine,
-  &AnalogOscillator::RenderTriangleFold,
-  &AnalogOscillator::RenderSineFold,
-  &AnalogOscillator::RenderBuzz,
+  &AnalogOscillator::RenderSaw<true>,
+  &AnalogOscillator::RenderVariableSaw<true>,
+  &AnalogOscillator::RenderCSaw<true>,
+  &AnalogOscillator::RenderSquare<true>,
+  &AnalogOscillator::RenderTriangle<true>,
+  &AnalogOscillator::RenderSine<true>,
+  &AnalogOscillator::RenderTriangleFold<true>,
+  &AnalogOscillator::RenderSineFold<true>,
+  &AnalogOscillator::RenderBuzz<true>,
+};
+
+/* static */
+AnalogOscillator::RenderFn AnalogOscillator::no_sync_fn_table_[] = {
+  &AnalogOscillator::RenderSaw<false>,
+  &AnalogOscillator::RenderVariableSaw<false>,
+  &AnalogOscillator::RenderCSaw<false>,
+  &AnalogOscillator::RenderSquare<false>,
+  &AnalogOscillator::RenderTriangle<false>,
+  &AnalogOscillator::RenderSine<false>,
+  &AnalogOscillator::RenderTriangleFold<false>,
+  &AnalogOscillator::RenderSineFold<false>,
+  &AnalogOscillator::RenderBuzz<false>,
 };
 
 }  // namespace braids
@@ -75,6 +75,7 @@ class AnalogOscillator {
     aux_parameter_ = 0;
     discontinuity_depth_ = -16383;
     pitch_ = 60 << 7;
+    increment_pitch_ = kNoPitch;
     next_sample_ = 0;
   }
   
@@ -102,6 +103,8 @@ class AnalogOscillator {
     phase_ = -phase_increment_;
   }
 
+  // sync_in may be NULL: no hard sync, rendered by variants of the shapes
+  // that do not test it on every sample.
   void Render(
       const uint8_t* sync_in,
       int16_t* buffer,
@@ -109,17 +112,29 @@ class AnalogOscillator {
       size_t size);
   
  private:
+  template<bool kSync>
   void RenderSquare(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderSaw(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderVariableSaw(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderCSaw(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderTriangle(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderSine(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderTriangleFold(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderSineFold(const uint8_t*, int16_t*, uint8_t*, size_t);
+  template<bool kSync>
   void RenderBuzz(const uint8_t*, int16_t*, uint8_t*, size_t);
   
   uint32_t ComputePhaseIncrement(int16_t midi_pitch);
+
+  // Outside the int16_t range: no increment computed yet.
+  static const int32_t kNoPitch = -65536;
   
   inline int32_t ThisBlepSample(uint32_t t) {
     if (t > 65535) {
@@ -146,6 +161,9 @@ class AnalogOscillator {
   int16_t aux_parameter_;
   int16_t discontinuity_depth_;
   int16_t pitch_;
+  // Pitch that phase_increment_ was computed for; the renderers only read
+  // phase_increment_, so Render() skips the lookup while the pitch holds.
+  int32_t increment_pitch_;
   
   int32_t next_sample_;
   
@@ -153,6 +171,7 @@ class AnalogOscillator {
   AnalogOscillatorShape previous_shape_;
   
   static RenderFn fn_table_[];
+  static RenderFn no_sync_fn_table_[];
   
   DISALLOW_COPY_AND_ASSIGN(AnalogOscillator);
 };
@@ -106,7 +106,7 @@ void DigitalOscillator::Render(
     parameter_[1] = a + ((b - a) * fractional >> 8);
   }    
   
-  RenderFn fn = fn_table_[shape_];
+  RenderFn fn = sync ? fn_table_[shape_] : no_sync_fn_table_[shape_];
   
   if (shape_ != previous_shape_) {
     Init();
@@ -114,8 +114,13 @@ void DigitalOscillator::Render(
     init_ = true;
   }
   
-  phase_increment_ = ComputePhaseIncrement(pitch_);
-  delay_ = ComputeDelay(pitch_);
+  if (pitch_ != increment_pitch_) {
+    pitch_phase_increment_ = ComputePhaseIncrement(pitch_);
+    pitch_delay_ = ComputeDelay(pitch_);
+    increment_pitch_ = pitch_;
+  }
+  phase_increment_ = pitch_phase_increment_;
+  delay_ = pitch_delay_;
   
   if (pitch_ > kHighestNote) {
     pitch_ = kHighestNote;
@@ -126,41 +131,64 @@ void DigitalOscillator::Render(
   (this->*fn)(sync, buffer, size);
 }
 
+/* static */
+size_t DigitalOscillator::DelayLinesSize(DigitalOscillatorShape shape) {
+  // Keyed on the render function: the physical modelling entries of
+  // fn_table_ are not in the same order as DigitalOscillatorShape.
+  DigitalOscillatorDelayLines* d = NULL;
+  RenderFn fn = fn_table_[shape];
+  if (fn == &DigitalOscillator::RenderComb) {
+    return sizeof(d->comb);
+  } else if (fn == &DigitalOscillator::RenderPlucked) {
+    return sizeof(d->ks);
+  } else if (fn == &DigitalOscillator::RenderBowed) {
+    return sizeof(d->bowed);
+  } else if (fn == &DigitalOscillator::RenderBlown) {
+    return sizeof(d->bore);
+  } else if (fn == &DigitalOscillator::RenderFluted) {
+    return sizeof(d->fluted);
+  }
+  return 0;
+}
+
+template<bool kSync>
 void DigitalOscillator::RenderTripleRingMod(
     const uint8_t* sync,
     int16_t* buffer,
     size_t size) {
-  uint32_t phase = phase_ + (1L << 30);
-  uint32_t increment = phase_increment_;
-  uint32_t modulator_phase = state_.vow.formant_phase[0];
-  uint32_t modulator_phase_2 = state_.vow.formant_phase[1];
-  uint32_t modulator_phase_increment = ComputePhaseIncrement(
-    pitch_ + ((parameter_[0] - 16384) >> 2)
-  );
-  uint32_t modulator_phase_increment_2 = ComputePhaseIncrement(
-    pitch_ + ((parameter_[1] - 16384) >> 2)
-  );
+  // Carrier and both modulators in lanes 0-2. The carrier advances before a
+  // sync reset, the modulators after it.
+  PhaseLanes phase = {
+      phase_ + (1 << 30),
+      state_.vow.formant_phase[0],
+      state_.vow.formant_phase[1],
+      0 };
+  PhaseLanes carrier_increment = { phase_increment_, 0, 0, 0 };
+  PhaseLanes modulator_increment = {
+      0,
+      ComputePhaseIncrement(pitch_ + ((parameter_[0] - 16384) >> 2)),
+      ComputePhaseIncrement(pitch_ + ((parameter_[1] - 16384) >> 2)),
+      0 };
   
   while (size--) {
-    phase += increment;
-    if (*sync++) {
-      phase = 0;
-      modulator_phase = 0;
-      modulator_phase_2 = 0;
-    }
-    modulator_phase += modulator_phase_increment;
-    modulator_phase_2 += modulator_phase_increment_2;
-    int16_t result = Interpolate824(wav_sine, phase);
-    result = result * Interpolate824(wav_sine, modulator_phase) >> 16;
-    result = result * Interpolate824(wav_sine, modulator_phase_2) >> 16;
+    phase += carrier_increment;
+    if (kSync && *sync++) {
+      phase = PhaseLanes { 0, 0, 0, 0 };
+    }
+    phase += modulator_increment;
+    SampleLanes sine = Interpolate824(wav_sine, phase);
+    int16_t result = sine[0];
+    result = result * sine[1] >> 16;
+    result = result * sine[2] >> 16;
     result = Interpolate88(ws_moderate_overdrive, result + 32768);
     *buffer++ = result;
   }
-  phase_ = phase - (1L << 30);
-  state_.vow.formant_phase[0] = modulator_phase;
-  state_.vow.formant_phase[1] = modulator_phase_2;
+  phase_ = phase[0] - (1L << 30);
+  state_.vow.formant_phase[0] = phase[1];
+  state_.vow.formant_phase[1] = phase[2];
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderSawSwarm(
     const uint8_t* sync,
     int16_t* buffer,
@@ -201,7 +229,7 @@ void DigitalOscillator::RenderSawSwarm(
   int32_t lp = state_.saw.lp;
 
   while (size--) {
-    if (*sync++) {
+    if (kSync && *sync++) {
       for (size_t i = 0; i < 6; ++i) {
         state_.saw.phase[i] = 0;
       }
@@ -251,7 +279,7 @@ void DigitalOscillator::RenderComb(
   filtered_pitch = (15 * filtered_pitch + pitch) >> 4;
   state_.ffm.previous_sample = filtered_pitch;
   
-  int16_t* dl = delay_lines_.comb;
+  int16_t* dl = delay_lines_->comb;
   uint32_t delay = ComputeDelay(filtered_pitch);
   if (delay > (kCombDelayLength << 16)) {
     delay = kCombDelayLength << 16;
@@ -282,6 +310,7 @@ void DigitalOscillator::RenderComb(
   phase_ = delay_ptr;
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderToy(
     const uint8_t* sync,
     int16_t* buffer,
@@ -298,7 +327,7 @@ void DigitalOscillator::RenderToy(
   uint8_t held_sample = state_.toy.held_sample;
   while (size--) {
     int32_t filtered_sample = 0;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase = 0;
     } 
     for (size_t tap = 0; tap < 4; ++tap) {
@@ -325,6 +354,7 @@ const uint32_t kPhaseReset[] = {
   0x80000000
 };
 
+template<bool kSync>
 void DigitalOscillator::RenderDigitalFilter(
     const uint8_t* sync,
     int16_t* buffer,
@@ -352,7 +382,7 @@ void DigitalOscillator::RenderDigitalFilter(
     modulator_phase += modulator_phase_increment;
     uint16_t integrator_gain = (modulator_phase_increment >> 14);
     
-    if (*sync++) {
+    if (kSync && *sync++) {
       state_.res.polarity = 1;
       phase_ = 0;
       modulator_phase = 0;
@@ -407,6 +437,7 @@ void DigitalOscillator::RenderDigitalFilter(
   state_.res.modulator_phase_increment = modulator_phase_increment;
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderVosim(
     const uint8_t* sync,
     int16_t* buffer,
@@ -416,7 +447,7 @@ void DigitalOscillator::RenderVosim(
   }
   while (size--) {
     phase_ += phase_increment_;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase_ = 0;
     }
     int32_t sample = 16384 + 8192;
@@ -502,33 +533,51 @@ void DigitalOscillator::RenderVowel(
   }
   int32_t noise = state_.vow.noise;
   
+  // The three formants in lanes 0-2. Without noise (every vowel) the random
+  // words would be multiplied by 0: the stream is only advanced past them.
+  uint32_t random_words[kMaxBlockSize];
+  const uint32_t* random_word = random_words;
+  if (noise) {
+    Random::Fill(random_words, size);
+  } else {
+    Random::Skip(size);
+  }
+  PhaseLanes phase = {
+      state_.vow.formant_phase[0],
+      state_.vow.formant_phase[1],
+      state_.vow.formant_phase[2],
+      0 };
+  const PhaseLanes increment = {
+      state_.vow.formant_increment[0],
+      state_.vow.formant_increment[1],
+      state_.vow.formant_increment[2],
+      0 };
+  const PhaseLanes amplitude = {
+      state_.vow.formant_amplitude[0],
+      state_.vow.formant_amplitude[1],
+      state_.vow.formant_amplitude[2],
+      0 };
+  
   while (size--) {
     phase_ += phase_increment_;
-    size_t phaselet;
-    int16_t sample = 0;
-    state_.vow.formant_phase[0] += state_.vow.formant_increment[0];
-    phaselet = (state_.vow.formant_phase[0] >> 24) & 0xf0;
-    sample += wav_formant_sine[phaselet | state_.vow.formant_amplitude[0]];
-
-    state_.vow.formant_phase[1] += state_.vow.formant_increment[1];
-    phaselet = (state_.vow.formant_phase[1] >> 24) & 0xf0;
-    sample += wav_formant_sine[phaselet | state_.vow.formant_amplitude[1]];
-    
-    state_.vow.formant_phase[2] += state_.vow.formant_increment[2];
-    phaselet = (state_.vow.formant_phase[2] >> 24) & 0xf0;
-    sample += wav_formant_square[phaselet | state_.vow.formant_amplitude[2]];
+    phase += increment;
+    PhaseLanes phaselet = ((phase >> 24) & 0xf0) | amplitude;
+    int16_t sample = wav_formant_sine[phaselet[0]];
+    sample += wav_formant_sine[phaselet[1]];
+    sample += wav_formant_square[phaselet[2]];
     
     sample *= 255 - (phase_ >> 24);
-    int32_t phase_noise = Random::GetSample() * noise;
+    int32_t phase_noise = noise ? Random::ToSample(*random_word++) * noise : 0;
     if ((phase_ + phase_noise) < phase_increment_) {
-      state_.vow.formant_phase[0] = 0;
-      state_.vow.formant_phase[1] = 0;
-      state_.vow.formant_phase[2] = 0;
+      phase = PhaseLanes { 0, 0, 0, 0 };
       sample = 0;
     }
     sample = Interpolate88(ws_moderate_overdrive, sample + 32768);
     *buffer++ = sample;
   }
+  for (size_t i = 0; i < 3; ++i) {
+    state_.vow.formant_phase[i] = phase[i];
+  }
 }
 
 static const int16_t formant_f_data[kNumFormants][kNumFormants][kNumFormants] = {
@@ -643,36 +692,51 @@ void DigitalOscillator::RenderVowelFof(
   // The original implementation used FOF but we live in the future and it's
   // less computationally expensive to render a proper bank of 5 SVF.
 
-  int16_t amplitudes[kNumFormants];
-  int32_t svf_lp[kNumFormants];
-  int32_t svf_bp[kNumFormants];
-  int16_t svf_f[kNumFormants];
-  
-  for (size_t i = 0; i < kNumFormants; ++i) {
-    int32_t frequency = InterpolateFormantParameter(
-        formant_f_data,
-        parameter_[1],
-        parameter_[0],
-        i) + (12 << 7);
-    svf_f[i] = Interpolate824(lut_svf_cutoff, frequency << 17);
-    amplitudes[i] = InterpolateFormantParameter(
+  // The coefficients only depend on the vowel (both parameters): they are
+  // looked up again only when it moves. Every formant is weighted by the
+  // first formant's amplitude, as in the original.
+  if (init_ ||
+      parameter_[0] != state_.fof.parameter[0] ||
+      parameter_[1] != state_.fof.parameter[1]) {
+    for (size_t i = 0; i < kNumFormants; ++i) {
+      int32_t frequency = InterpolateFormantParameter(
+          formant_f_data,
+          parameter_[1],
+          parameter_[0],
+          i) + (12 << 7);
+      state_.fof.svf_f[i] = Interpolate824(lut_svf_cutoff, frequency << 17);
+    }
+    state_.fof.amplitude = InterpolateFormantParameter(
         formant_a_data,
         parameter_[1],
         parameter_[0],
-        i);
-    if (init_) {
-      svf_lp[i] = 0;
-      svf_bp[i] = 0;
-    } else {
-      svf_lp[i] = state_.fof.svf_lp[i];
-      svf_bp[i] = state_.fof.svf_bp[i];
-    }
+        0);
+    state_.fof.parameter[0] = parameter_[0];
+    state_.fof.parameter[1] = parameter_[1];
   }
   
   if (init_) {
+    for (size_t i = 0; i < kNumFormants; ++i) {
+      state_.fof.svf_lp[i] = 0;
+      state_.fof.svf_bp[i] = 0;
+    }
     init_ = false;
   }
   
+  // The filter bank, four formants per lane vector; the spare lanes have no
+  // cutoff, so they stay silent.
+  const size_t kGroups = (kNumFormants + kNumLanes - 1) / kNumLanes;
+  SampleLanes svf_f[kGroups];
+  SampleLanes svf_lp[kGroups];
+  SampleLanes svf_bp[kGroups];
+  for (size_t i = 0; i < kGroups * kNumLanes; ++i) {
+    bool used = i < kNumFormants;
+    svf_f[i / kNumLanes][i % kNumLanes] = used ? state_.fof.svf_f[i] : 0;
+    svf_lp[i / kNumLanes][i % kNumLanes] = used ? state_.fof.svf_lp[i] : 0;
+    svf_bp[i / kNumLanes][i % kNumLanes] = used ? state_.fof.svf_bp[i] : 0;
+  }
+  int32_t amplitude = state_.fof.amplitude;
+  
   uint32_t phase = phase_;
   int32_t previous_sample = state_.fof.previous_sample;
   int32_t next_saw_sample = state_.fof.next_saw_sample;
@@ -691,17 +755,17 @@ void DigitalOscillator::RenderVowelFof(
       next_saw_sample -= -static_cast<int32_t>(t * t >> 18);
     }
     next_saw_sample += phase >> 17;
-    int32_t in = this_saw_sample;
-    int32_t out = 0;
-    for (int32_t i = 0; i < 5; ++i) {
-      int32_t notch = in - (svf_bp[i] >> 6);
-      svf_lp[i] += svf_f[i] * svf_bp[i] >> 15;
-      CLIP(svf_lp[i])
-      int32_t hp = notch - svf_lp[i];
-      svf_bp[i] += svf_f[i] * hp >> 15;
-      CLIP(svf_bp[i])
-      out += svf_bp[i] * amplitudes[0] >> 17;
-    }
+    SampleLanes in = {
+        this_saw_sample, this_saw_sample, this_saw_sample, this_saw_sample };
+    SampleLanes sum = { 0, 0, 0, 0 };
+    for (size_t g = 0; g < kGroups; ++g) {
+      SampleLanes notch = in - (svf_bp[g] >> 6);
+      svf_lp[g] = ClipLanes(svf_lp[g] + (svf_f[g] * svf_bp[g] >> 15));
+      SampleLanes hp = notch - svf_lp[g];
+      svf_bp[g] = ClipLanes(svf_bp[g] + (svf_f[g] * hp >> 15));
+      sum += svf_bp[g] * amplitude >> 17;
+    }
+    int32_t out = SumLanes(sum);
     CLIP(out);
     *buffer++ = (out + previous_sample) >> 1;
     *buffer++ = out;
@@ -712,11 +776,12 @@ void DigitalOscillator::RenderVowelFof(
   state_.fof.next_saw_sample = next_saw_sample;
   state_.fof.previous_sample = previous_sample;
   for (size_t i = 0; i < kNumFormants; ++i) {
-    state_.fof.svf_lp[i] = svf_lp[i];
-    state_.fof.svf_bp[i] = svf_bp[i];
+    state_.fof.svf_lp[i] = svf_lp[i / kNumLanes][i % kNumLanes];
+    state_.fof.svf_bp[i] = svf_bp[i / kNumLanes][i % kNumLanes];
   }
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderFm(
     const uint8_t* sync,
     int16_t* buffer,
@@ -731,7 +796,7 @@ void DigitalOscillator::RenderFm(
     INTERPOLATE_PARAMETER_0
     
     phase_ += phase_increment_;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase_ = modulator_phase = 0;
     }
     modulator_phase += modulator_phase_increment;
@@ -746,6 +811,7 @@ void DigitalOscillator::RenderFm(
   state_.modulator_phase = modulator_phase;
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderFeedbackFm(
     const uint8_t* sync,
     int16_t* buffer,
@@ -767,7 +833,7 @@ void DigitalOscillator::RenderFeedbackFm(
     INTERPOLATE_PARAMETER_0
     
     phase_ += phase_increment_;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase_ = modulator_phase = 0;
     }
     
@@ -788,6 +854,7 @@ void DigitalOscillator::RenderFeedbackFm(
   state_.ffm.modulator_phase = modulator_phase;
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderChaoticFeedbackFm(
     const uint8_t* sync,
     int16_t* buffer,
@@ -803,7 +870,7 @@ void DigitalOscillator::RenderChaoticFeedbackFm(
     INTERPOLATE_PARAMETER_0
     
     phase_ += phase_increment_;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase_ = modulator_phase = 0;
     }
     
@@ -903,22 +970,43 @@ void DigitalOscillator::RenderStruckBell(
     }
   }
   
+  // The partials, four per lane vector; the spare lanes have no amplitude.
+  const size_t kGroups = (kNumBellPartials + kNumLanes - 1) / kNumLanes;
+  static_assert(kNumReducedPartials % kNumLanes == 0, "Whole lane groups");
+  const size_t groups = reduced_partials_
+      ? kNumReducedPartials / kNumLanes : kGroups;
+  PhaseLanes phase[kGroups];
+  PhaseLanes increment[kGroups];
+  SampleLanes amplitude[kGroups];
+  for (size_t i = 0; i < kGroups * kNumLanes; ++i) {
+    bool used = i < kNumBellPartials;
+    phase[i / kNumLanes][i % kNumLanes] = used ? state_.add.partial_phase[i] : 0;
+    increment[i / kNumLanes][i % kNumLanes] = \
+        used ? state_.add.partial_phase_increment[i] : 0;
+    amplitude[i / kNumLanes][i % kNumLanes] = \
+        used ? state_.add.partial_amplitude[i] : 0;
+  }
+  
   int16_t previous_sample = state_.add.previous_sample;
   while (size--) {
-    int32_t out = 0;
-    for (size_t i = 0; i < kNumBellPartials; ++i) {
-      state_.add.partial_phase[i] += state_.add.partial_phase_increment[i];
-      int32_t partial = Interpolate824(wav_sine, state_.add.partial_phase[i]);
-      out += partial * state_.add.partial_amplitude[i] >> 17;
+    SampleLanes sum = { 0, 0, 0, 0 };
+    for (size_t g = 0; g < groups; ++g) {
+      phase[g] += increment[g];
+      sum += Interpolate824(wav_sine, phase[g]) * amplitude[g] >> 17;
     }
+    int32_t out = SumLanes(sum);
     CLIP(out)
     *buffer++ = (out + previous_sample) >> 1;
     *buffer++ = out; size--;
     previous_sample = out;
   }
   state_.add.previous_sample = previous_sample;
+  for (size_t i = 0; i < kNumBellPartials; ++i) {
+    state_.add.partial_phase[i] = phase[i / kNumLanes][i % kNumLanes];
+  }
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderHarmonics(
     const uint8_t* sync,
     int16_t* buffer,
@@ -927,7 +1015,6 @@ void DigitalOscillator::RenderHarmonics(
   int16_t previous_sample = state_.add.previous_sample;
   uint32_t phase_increment = phase_increment_ << 1;
   int32_t target_amplitude[kNumAdditiveHarmonics];
-  int32_t amplitude[kNumAdditiveHarmonics];
   
   int32_t peak = (kNumAdditiveHarmonics * parameter_[0]) >> 7;
   int32_t second_peak = (peak >> 1) + kNumAdditiveHarmonics * 128;
@@ -937,8 +1024,10 @@ void DigitalOscillator::RenderHarmonics(
       ? parameter_[1] >> 6 : 511 - (parameter_[1] >> 6);
   int32_t sqrt_width = sqrtsqrt_width * sqrtsqrt_width >> 10;
   int32_t width = sqrt_width * sqrt_width + 4;
+  const size_t num_harmonics = reduced_partials_
+      ? kNumReducedPartials : kNumAdditiveHarmonics;
   int32_t total = 0;
-  for (size_t i = 0; i < kNumAdditiveHarmonics; ++i) {
+  for (size_t i = 0; i < num_harmonics; ++i) {
     int32_t x = i << 8;
     int32_t d, g;
 
@@ -952,27 +1041,44 @@ void DigitalOscillator::RenderHarmonics(
   }
   
   int32_t attenuation = 2147483647 / total;
-  for (size_t i = 0; i < kNumAdditiveHarmonics; ++i) {
+  for (size_t i = 0; i < num_harmonics; ++i) {
     if ((phase_increment >> 16) * (i + 1) > 0x4000) {
       target_amplitude[i] = 0;
     } else {
       target_amplitude[i] = target_amplitude[i] * attenuation >> 16;
     }
-    amplitude[i] = state_.hrm.amplitude[i];
+  }
+  
+  // The harmonics, four per lane vector.
+  // With reduced partials, the upper groups keep their levels, unrendered.
+  const size_t kGroups = kNumAdditiveHarmonics / kNumLanes;
+  static_assert(kNumAdditiveHarmonics % kNumLanes == 0, "Whole lane groups");
+  const size_t groups = num_harmonics / kNumLanes;
+  PhaseLanes rank[kGroups];
+  SampleLanes target[kGroups];
+  SampleLanes level[kGroups];
+  for (size_t i = num_harmonics; i < kNumAdditiveHarmonics; ++i) {
+    target_amplitude[i] = state_.hrm.amplitude[i];
+  }
+  for (size_t i = 0; i < kNumAdditiveHarmonics; ++i) {
+    rank[i / kNumLanes][i % kNumLanes] = i + 1;
+    target[i / kNumLanes][i % kNumLanes] = target_amplitude[i];
+    level[i / kNumLanes][i % kNumLanes] = state_.hrm.amplitude[i];
   }
   
   while (size) {
     int32_t out;
     
     phase += phase_increment;
-    if (*sync++ || *sync++) {
+    if (kSync && (*sync++ || *sync++)) {
       phase = 0;
     }
-    out = 0;
-    for (size_t i = 0; i < kNumAdditiveHarmonics; ++i) {
-      out += Interpolate824(wav_sine, phase * (i + 1)) * amplitude[i] >> 15;
-      amplitude[i] += (target_amplitude[i] - amplitude[i]) >> 8;
+    SampleLanes sum = { 0, 0, 0, 0 };
+    for (size_t g = 0; g < groups; ++g) {
+      sum += Interpolate824(wav_sine, phase * rank[g]) * level[g] >> 15;
+      level[g] += (target[g] - level[g]) >> 8;
     }
+    out = SumLanes(sum);
     CLIP(out)
     *buffer++ = (out + previous_sample) >> 1;
     *buffer++ = out;
@@ -982,7 +1088,7 @@ void DigitalOscillator::RenderHarmonics(
   state_.add.previous_sample = previous_sample;
   phase_ = phase;
   for (size_t i = 0; i < kNumAdditiveHarmonics; ++i) {
-    state_.hrm.amplitude[i] = amplitude[i];
+    state_.hrm.amplitude[i] = level[i / kNumLanes][i % kNumLanes];
   }
 }
 
@@ -1034,13 +1140,34 @@ void DigitalOscillator::RenderStruckDrum(
   int32_t noise_mode_gain = parameter_[1] < 16384 ? 0 : parameter_[1] - 16384;
   noise_mode_gain = noise_mode_gain * 12888 >> 14;
 
+  // The partials, four per lane vector; the spare lanes have no amplitude.
+  const size_t kGroups = (kNumDrumPartials + kNumLanes - 1) / kNumLanes;
+  PhaseLanes phase[kGroups];
+  PhaseLanes increment[kGroups];
+  SampleLanes amplitude[kGroups];
+  SampleLanes amplitude_delta[kGroups];
+  for (size_t i = 0; i < kGroups * kNumLanes; ++i) {
+    AdditiveState* a = &state_.add;
+    bool used = i < kNumDrumPartials;
+    phase[i / kNumLanes][i % kNumLanes] = used ? a->partial_phase[i] : 0;
+    increment[i / kNumLanes][i % kNumLanes] = \
+        used ? a->partial_phase_increment[i] : 0;
+    amplitude[i / kNumLanes][i % kNumLanes] = \
+        used ? a->partial_amplitude[i] : 0;
+    amplitude_delta[i / kNumLanes][i % kNumLanes] = \
+        used ? a->target_partial_amplitude[i] - a->partial_amplitude[i] : 0;
+  }
+
   int32_t fade_increment = 65536 / size;
   int32_t fade = 0;
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, (size + 1) / 2);
+  const uint32_t* random_word = random_words;
   while (size--) {
     fade += fade_increment;
     int32_t harmonics = 0;
 
-    int32_t noise = Random::GetSample();
+    int32_t noise = Random::ToSample(*random_word++);
     if (noise > 16384) {
       noise = 16384;
     }
@@ -1051,20 +1178,16 @@ void DigitalOscillator::RenderStruckDrum(
     lp_state_1 += (lp_state_0 - lp_state_1) * f >> 15;
     lp_state_2 += (lp_state_1 - lp_state_2) * f >> 15;
 
-    int32_t partials[kNumDrumPartials];
-    for (size_t i = 0; i < kNumDrumPartials; ++i) {
-      AdditiveState* a = &state_.add;
-      a->partial_phase[i] += a->partial_phase_increment[i];
-      int32_t partial = Interpolate824(wav_sine, a->partial_phase[i]);
-      int32_t amplitude = a->partial_amplitude[i] + \
-          (((a->target_partial_amplitude[i] - a->partial_amplitude[i]) * fade) >> 15);
-      partial = partial * amplitude >> 16;
-      harmonics += partial;
-      partials[i] = partial;
-    }
-    int32_t sample = partials[0];
-    int32_t noise_mode_1 = partials[1] * lp_state_2 >> 8;
-    int32_t noise_mode_2 = partials[3] * lp_state_2 >> 9;
+    SampleLanes partials[kGroups];
+    for (size_t g = 0; g < kGroups; ++g) {
+      phase[g] += increment[g];
+      SampleLanes faded = amplitude[g] + (amplitude_delta[g] * fade >> 15);
+      partials[g] = Interpolate824(wav_sine, phase[g]) * faded >> 16;
+      harmonics += SumLanes(partials[g]);
+    }
+    int32_t sample = partials[0][0];
+    int32_t noise_mode_1 = partials[0][1] * lp_state_2 >> 8;
+    int32_t noise_mode_2 = partials[0][3] * lp_state_2 >> 9;
     sample += noise_mode_1 * (12288 - noise_mode_gain) >> 14;
     sample += noise_mode_2 * noise_mode_gain >> 14;
     sample += harmonics * harmonics_gain >> 14;
@@ -1078,6 +1201,9 @@ void DigitalOscillator::RenderStruckDrum(
   state_.add.lp_noise[0] = lp_state_0;
   state_.add.lp_noise[1] = lp_state_1;
   state_.add.lp_noise[2] = lp_state_2;
+  for (size_t i = 0; i < kNumDrumPartials; ++i) {
+    state_.add.partial_phase[i] = phase[i / kNumLanes][i % kNumLanes];
+  }
   for (size_t i = 0; i < kNumBellPartials; ++i) {
     AdditiveState* a = &state_.add;
     a->partial_amplitude[i] = a->target_partial_amplitude[i];
@@ -1141,7 +1267,7 @@ void DigitalOscillator::RenderPlucked(
     int32_t sample = 0;
     for (size_t i = 0; i < kNumPluckVoices; ++i) {
       PluckState* p = &state_.plk[i];
-      int16_t* dl = delay_lines_.ks + i * 1025;
+      int16_t* dl = delay_lines_->ks + i * 1025;
       // Initialization: Just use a white noise sample and fill the delay
       // line.
       if (p->initialization_ptr) {
@@ -1197,12 +1323,12 @@ void DigitalOscillator::RenderBowed(
     const uint8_t* sync,
     int16_t* buffer,
     size_t size) {
-  int8_t* dl_b = delay_lines_.bowed.bridge;
-  int8_t* dl_n = delay_lines_.bowed.neck;
+  int8_t* dl_b = delay_lines_->bowed.bridge;
+  int8_t* dl_n = delay_lines_->bowed.neck;
   
   if (strike_) {
-    memset(dl_b, 0, sizeof(delay_lines_.bowed.bridge));
-    memset(dl_n, 0, sizeof(delay_lines_.bowed.neck));
+    memset(dl_b, 0, sizeof(delay_lines_->bowed.bridge));
+    memset(dl_n, 0, sizeof(delay_lines_->bowed.neck));
     memset(&state_, 0, sizeof(state_));
     strike_ = false;
   }
@@ -1281,7 +1407,10 @@ void DigitalOscillator::RenderBowed(
     *buffer++ = (out + previous_sample) >> 1;
     *buffer++ = out;
     previous_sample = out;
-    ++excitation_ptr;
+    // Blocks longer than the table's 32 entries of padding stop at its end.
+    if (excitation_ptr < (LUT_BOWING_ENVELOPE_SIZE << 1) - 3) {
+      ++excitation_ptr;
+    }
     size -= 2;
   }
   if ((excitation_ptr >> 1) >= LUT_BOWING_ENVELOPE_SIZE - 32) {
@@ -1307,9 +1436,9 @@ void DigitalOscillator::RenderBlown(
   uint16_t delay_ptr = state_.phy.delay_ptr;
   int32_t lp_state = state_.phy.lp_state;
   
-  int16_t* dl = delay_lines_.bore;
+  int16_t* dl = delay_lines_->bore;
   if (strike_) {
-    memset(dl, 0, sizeof(delay_lines_.bore));
+    memset(dl, 0, sizeof(delay_lines_->bore));
     strike_ = false;
   }
 
@@ -1328,10 +1457,13 @@ void DigitalOscillator::RenderBlown(
     normalized_pitch = 127;
   }
   uint16_t filter_coefficient = lut_flute_body_filter[normalized_pitch];
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, size);
+  const uint32_t* random_word = random_words;
   while (size--) {
     phase_ += phase_increment_;
     
-    int32_t breath_pressure = Random::GetSample() * parameter >> 15;
+    int32_t breath_pressure = Random::ToSample(*random_word++) * parameter >> 15;
     breath_pressure = breath_pressure * kBreathPressure >> 15;
     breath_pressure += kBreathPressure;
     
@@ -1375,13 +1507,13 @@ void DigitalOscillator::RenderFluted(
   int32_t dc_blocking_x0 = state_.phy.filter_state[0];
   int32_t dc_blocking_y0 = state_.phy.filter_state[1];
 
-  int8_t* dl_b = delay_lines_.fluted.bore;
-  int8_t* dl_j = delay_lines_.fluted.jet;
+  int8_t* dl_b = delay_lines_->fluted.bore;
+  int8_t* dl_j = delay_lines_->fluted.jet;
   
   if (strike_) {
     excitation_ptr = 0;
-    memset(dl_b, 0, sizeof(delay_lines_.fluted.bore));
-    memset(dl_j, 0, sizeof(delay_lines_.fluted.jet));
+    memset(dl_b, 0, sizeof(delay_lines_->fluted.bore));
+    memset(dl_j, 0, sizeof(delay_lines_->fluted.jet));
     lp_state = 0;
     strike_ = false;
   }
@@ -1402,6 +1534,9 @@ void DigitalOscillator::RenderFluted(
   
   uint16_t breath_intensity = 2100 - (parameter_[0] >> 4);
   uint16_t filter_coefficient = lut_flute_body_filter[pitch_ >> 7];
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, size);
+  const uint32_t* random_word = random_words;
   while (size--) {
     phase_ += phase_increment_;
     
@@ -1418,7 +1553,7 @@ void DigitalOscillator::RenderFluted(
         
     int32_t breath_pressure = lut_blowing_envelope[excitation_ptr];
     breath_pressure <<= 1;
-    int32_t random_pressure = Random::GetSample() * breath_intensity >> 12;
+    int32_t random_pressure = Random::ToSample(*random_word++) * breath_intensity >> 12;
     random_pressure = random_pressure * breath_pressure >> 15;
     breath_pressure += random_pressure;
     
@@ -1449,7 +1584,8 @@ void DigitalOscillator::RenderFluted(
     int32_t out = bore_value >> 1;
     CLIP(out)
     *buffer++ = out;
-    if (size & 3) {
+    // Blocks longer than the table's 32 entries of padding stop at its end.
+    if ((size & 3) && excitation_ptr < LUT_BLOWING_ENVELOPE_SIZE - 1) {
       ++excitation_ptr;
     }
   }
@@ -1522,6 +1658,7 @@ static const WavetableDefinition wavetable_definitions[] = {
 { 4 , { 252, 253, 254, 255, 254 } },
 };
 
+template<bool kSync>
 void DigitalOscillator::RenderWavetables(
     const uint8_t* sync,
     int16_t* buffer,
@@ -1551,7 +1688,7 @@ void DigitalOscillator::RenderWavetables(
     int16_t sample;
     // 2x naive oversampling.
     phase_ += phase_increment;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase_ = 0;
     }
     
@@ -1562,6 +1699,7 @@ void DigitalOscillator::RenderWavetables(
   }
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderWaveMap(
     const uint8_t* sync,
     int16_t* buffer,
@@ -1594,7 +1732,7 @@ void DigitalOscillator::RenderWaveMap(
     int16_t sample;
     // 2x naive oversampling.
     phase_ += phase_increment;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase_ = 0;
     }
     
@@ -1625,6 +1763,7 @@ static const uint8_t mini_wave_line[] = {
   135, 174
 };
 
+template<bool kSync>
 void DigitalOscillator::RenderWaveLine(
     const uint8_t* sync,
     int16_t* buffer,
@@ -1648,7 +1787,7 @@ void DigitalOscillator::RenderWaveLine(
   
   if (parameter_[1] < 8192) {
     while (size--) {
-      if (*sync++) {
+      if (kSync && *sync++) {
         phase = 0;
       }
       int32_t sample = 0;
@@ -1669,7 +1808,7 @@ void DigitalOscillator::RenderWaveLine(
     }
   } else if (parameter_[1] < 16384) {
     while (size--) {
-      if (*sync++) {
+      if (kSync && *sync++) {
         phase = 0;
       }
       int32_t sample = 0;
@@ -1690,7 +1829,7 @@ void DigitalOscillator::RenderWaveLine(
     }
   } else if (parameter_[1] < 24576) {
     while (size--) {
-      if (*sync++) {
+      if (kSync && *sync++) {
         phase = 0;
       }
       int32_t sample = 0;
@@ -1709,7 +1848,7 @@ void DigitalOscillator::RenderWaveLine(
     }
   } else {
     while (size--) {
-      if (*sync++) {
+      if (kSync && *sync++) {
         phase = 0;
       }
       int32_t sample = 0;
@@ -1853,10 +1992,13 @@ void DigitalOscillator::RenderFilteredNoise(
   }
   
   int32_t gain_correction = f > scale ? scale * 32767 / f : 32767;
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, size);
+  const uint32_t* random_word = random_words;
   while (size--) {
     int32_t notch, hp, in;
     
-    in = Random::GetSample() >> 1;
+    in = Random::ToSample(*random_word++) >> 1;
     notch = in - (bp * damp >> 15);
     lp += f * bp >> 15;
     CLIP(lp)
@@ -1903,8 +2045,11 @@ void DigitalOscillator::RenderTwinPeaksNoise(
 
   int32_t makeup_gain = 8191 - (parameter_[0] >> 2);
   
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, (size + 1) / 2);
+  const uint32_t* random_word = random_words;
   while (size) {    
-    sample = Random::GetSample() >> 1;
+    sample = Random::ToSample(*random_word++) >> 1;
     
     if (sample > 0) {
       y10 = sample * s1 >> 16;
@@ -1943,6 +2088,7 @@ void DigitalOscillator::RenderTwinPeaksNoise(
   state_.pno.filter_state[1][1] = y22;
 }
 
+template<bool kSync>
 void DigitalOscillator::RenderClockedNoise(
     const uint8_t* sync,
     int16_t* buffer,
@@ -1986,7 +2132,7 @@ void DigitalOscillator::RenderClockedNoise(
   uint32_t quantizer_divider = 65536 / num_steps;
   while (size--) {
     phase += phase_increment;
-    if (*sync++) {
+    if (kSync && *sync++) {
       phase = 0;
     }
     
@@ -2099,8 +2245,11 @@ void DigitalOscillator::RenderParticleNoise(
   int32_t s3 = state_.pno.filter_scale[2];
   int32_t c3 = state_.pno.filter_coefficient[2];
 
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, (size + 1) / 2);
+  const uint32_t* random_word = random_words;
   while (size) {
-    uint32_t noise = Random::GetWord();
+    uint32_t noise = *random_word++;
     if ((noise & 0x7fffff) < density) {
       amplitude = 65535;
       int16_t noise_a = (noise & 0x0fff) - 0x800;
@@ -2424,6 +2573,9 @@ void DigitalOscillator::RenderSnare(
   int32_t g_1 = 22000 - (parameter_[0] >> 1);
   int32_t g_2 = 22000 + (parameter_[0] >> 1);
 
+  uint32_t random_words[kMaxBlockSize];
+  Random::Fill(random_words, (size + 1) / 2);
+  const uint32_t* random_word = random_words;
   while (size) {
     int32_t excitation_1 = 0;
     excitation_1 += pulse_[0].Process();
@@ -2434,7 +2586,7 @@ void DigitalOscillator::RenderSnare(
     excitation_2 += pulse_[2].Process();
     excitation_2 += !pulse_[2].done() ? 13107 : 0;
     
-    int32_t noise_sample = Random::GetSample() * pulse_[3].Process() >> 15;
+    int32_t noise_sample = Random::ToSample(*random_word++) * pulse_[3].Process() >> 15;
     
     int32_t sd = 0;
     sd += (svf_[0].Process(excitation_1) + (excitation_1 >> 4)) * g_1 >> 15;
@@ -2525,21 +2677,62 @@ void DigitalOscillator::RenderYourAlgo(
 
 /* static */
 DigitalOscillator::RenderFn DigitalOscillator::fn_table_[] = {
-  &DigitalOscillator::RenderTripleRingMod,
-  &DigitalOscillator::RenderSawSwarm,
+  &DigitalOscillator::RenderTripleRingMod<true>,
+  &DigitalOscillator::RenderSawSwarm<true>,
+  &DigitalOscillator::RenderComb,
+  &DigitalOscillator::RenderToy<true>,
+  &DigitalOscillator::RenderDigitalFilter<true>,
+  &DigitalOscillator::RenderDigitalFilter<true>,
+  &DigitalOscillator::RenderDigitalFilter<true>,
+  &DigitalOscillator::RenderDigitalFilter<true>,
+  &DigitalOscillator::RenderVosim<true>,
+  &DigitalOscillator::RenderVowel,
+  &DigitalOscillator::RenderVowelFof,
+  &DigitalOscillator::RenderHarmonics<true>,
+  &DigitalOscillator::RenderFm<true>,
+  &DigitalOscillator::RenderFeedbackFm<true>,
+  &DigitalOscillator::RenderChaoticFeedbackFm<true>,
+  &DigitalOscillator::RenderPlucked,
+  &DigitalOscillator::RenderBowed,
+  &DigitalOscillator::RenderBlown,
+  &DigitalOscillator::RenderFluted,
+  &DigitalOscillator::RenderStruckBell,
+  &DigitalOscillator::RenderStruckDrum,
+  &DigitalOscillator::RenderKick,
+  &DigitalOscillator::RenderCymbal,
+  &DigitalOscillator::RenderSnare,
+  &DigitalOscillator::RenderWavetables<true>,
+  &DigitalOscillator::RenderWaveMap<true>,
+  &DigitalOscillator::RenderWaveLine<true>,
+  &DigitalOscillator::RenderWaveParaphonic,
+  &DigitalOscillator::RenderFilteredNoise,
+  &DigitalOscillator::RenderTwinPeaksNoise,
+  &DigitalOscillator::RenderClockedNoise<true>,
+  &DigitalOscillator::RenderGranularCloud,
+  &DigitalOscillator::RenderParticleNoise,
+  &DigitalOscillator::RenderDigitalModulation,
+  // &DigitalOscillator::RenderYourAlgo,
+
+  &DigitalOscillator::RenderQuestionMark
+};
+
+/* static */
+DigitalOscillator::RenderFn DigitalOscillator::no_sync_fn_table_[] = {
+  &DigitalOscillator::RenderTripleRingMod<false>,
+  &DigitalOscillator::RenderSawSwarm<false>,
   &DigitalOscillator::RenderComb,
-  &DigitalOscillator::RenderToy,
-  &DigitalOscillator::RenderDigitalFilter,
-  &DigitalOscillator::RenderDigitalFilter,
-  &DigitalOscillator::RenderDigitalFilter,
-  &DigitalOscillator::RenderDigitalFilter,
-  &DigitalOscillator::RenderVosim,
+  &DigitalOscillator::RenderToy<false>,
+  &DigitalOscillator::RenderDigitalFilter<false>,
+  &DigitalOscillator::RenderDigitalFilter<false>,
+  &DigitalOscillator::RenderDigitalFilter<false>,
+  &DigitalOscillator::RenderDigitalFilter<false>,
+  &DigitalOscillator::RenderVosim<false>,
   &DigitalOscillator::RenderVowel,
   &DigitalOscillator::RenderVowelFof,
-  &DigitalOscillator::RenderHarmonics,
-  &DigitalOscillator::RenderFm,
-  &DigitalOscillator::RenderFeedbackFm,
-  &DigitalOscillator::RenderChaoticFeedbackFm,
+  &DigitalOscillator::RenderHarmonics<false>,
+  &DigitalOscillator::RenderFm<false>,
+  &DigitalOscillator::RenderFeedbackFm<false>,
+  &DigitalOscillator::RenderChaoticFeedbackFm<false>,
   &DigitalOscillator::RenderPlucked,
   &DigitalOscillator::RenderBowed,
   &DigitalOscillator::RenderBlown,
@@ -2549,13 +2742,13 @@ DigitalOscillator::RenderFn DigitalOscillator::fn_table_[] = {
   &DigitalOscillator::RenderKick,
   &DigitalOscillator::RenderCymbal,
   &DigitalOscillator::RenderSnare,
-  &DigitalOscillator::RenderWavetables,
-  &DigitalOscillator::RenderWaveMap,
-  &DigitalOscillator::RenderWaveLine,
+  &DigitalOscillator::RenderWavetables<false>,
+  &DigitalOscillator::RenderWaveMap<false>,
+  &DigitalOscillator::RenderWaveLine<false>,
   &DigitalOscillator::RenderWaveParaphonic,
   &DigitalOscillator::RenderFilteredNoise,
   &DigitalOscillator::RenderTwinPeaksNoise,
-  &DigitalOscillator::RenderClockedNoise,
+  &DigitalOscillator::RenderClockedNoise<false>,
   &DigitalOscillator::RenderGranularCloud,
   &DigitalOscillator::RenderParticleNoise,
   &DigitalOscillator::RenderDigitalModulation,
@@ -32,18 +32,25 @@
 #include "stmlib/stmlib.h"
 
 #include "braids/excitation.h"
+#include "braids/resources.h"
 #include "braids/svf.h"
 
 #include <cstring>
 
 namespace braids {
 
-static const size_t kWGBridgeLength = 1024;
-static const size_t kWGNeckLength = 4096;
-static const size_t kWGBoreLength = 2048;
-static const size_t kWGJetLength = 1024;
-static const size_t kWGFBoreLength = 4096;
-static const size_t kCombDelayLength = 8192;
+// Largest block size MacroOscillator::Render() accepts (the module itself
+// uses 24). The noise engines draw a block of random words at once.
+const size_t kMaxBlockSize = 64;
+
+// Delay line lengths are those of the 96 kHz firmware, scaled down with the
+// sample rate the tables were generated for. They stay powers of two.
+static const size_t kWGBridgeLength = 1024 >> kDelayLineShift;
+static const size_t kWGNeckLength = 4096 >> kDelayLineShift;
+static const size_t kWGBoreLength = 2048 >> kDelayLineShift;
+static const size_t kWGJetLength = 1024 >> kDelayLineShift;
+static const size_t kWGFBoreLength = 4096 >> kDelayLineShift;
+static const size_t kCombDelayLength = 8192 >> kDelayLineShift;
 
 static const size_t kNumFormants = 5;
 static const size_t kNumPluckVoices = 3;
@@ -51,6 +58,8 @@ static const size_t kNumOverlappingFof = 3;
 static const size_t kNumBellPartials = 11;
 static const size_t kNumDrumPartials = 6;
 static const size_t kNumAdditiveHarmonics = 12;
+// With reduced partials: the lowest two lane groups of each.
+static const size_t kNumReducedPartials = 8;
 
 enum DigitalOscillatorShape {
   OSC_SHAPE_TRIPLE_RING_MOD,
@@ -184,6 +193,10 @@ struct FofState {
   int16_t previous_sample;
   int32_t svf_lp[kNumFormants];
   int32_t svf_bp[kNumFormants];
+  // Filter bank coefficients, kept for the parameters they were computed for.
+  int16_t svf_f[kNumFormants];
+  int16_t amplitude;
+  int16_t parameter[2];
 };
 
 struct ToyState {
@@ -236,6 +249,23 @@ union DigitalOscillatorState {
   uint32_t modulator_phase;
 };
 
+// Delay lines of the comb filter and physical modelling engines. By far the
+// largest part of the oscillator state and only used by five shapes, so the
+// storage is owned by the caller (see set_delay_lines and DelayLinesSize).
+union DigitalOscillatorDelayLines {
+  int16_t comb[kCombDelayLength];
+  int16_t ks[1025 * 4];
+  struct {
+    int8_t bridge[kWGBridgeLength];
+    int8_t neck[kWGNeckLength];
+  } bowed;
+  int16_t bore[kWGBoreLength];
+  struct {
+    int8_t jet[kWGJetLength];
+    int8_t bore[kWGFBoreLength];
+  } fluted;
+};
+
 class DigitalOscillator {
  public:
   typedef void (DigitalOscillator::*RenderFn)(const uint8_t*, int16_t*, size_t);
@@ -255,6 +285,7 @@ class DigitalOscillator {
     phase_ = 0;
     strike_ = true;
     init_ = true;
+    increment_pitch_ = kNoPitch;
   }
   
   inline void set_shape(DigitalOscillatorShape shape) {
@@ -285,23 +316,49 @@ class DigitalOscillator {
     strike_ = true;
   }
 
+  // Must point to at least DelayLinesSize(shape) bytes before a shape that
+  // uses delay lines is rendered. May be NULL otherwise.
+  inline void set_delay_lines(DigitalOscillatorDelayLines* delay_lines) {
+    delay_lines_ = delay_lines;
+  }
+
+  // Render only the lowest kNumReducedPartials partials of the additive
+  // shapes (HARMONICS, STRUCK_BELL), to save CPU. Survives Init().
+  inline void set_reduced_partials(bool reduced) {
+    reduced_partials_ = reduced;
+  }
+
+  // Bytes of delay line storage the shape needs (0 for most shapes).
+  static size_t DelayLinesSize(DigitalOscillatorShape shape);
+
+  // sync may be NULL: no hard sync, rendered by variants of the shapes that
+  // do not test it on every sample.
   void Render(const uint8_t* sync, int16_t* buffer, size_t size);
   
  private:
+  template<bool kSync>
   void RenderTripleRingMod(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderSawSwarm(const uint8_t*, int16_t*, size_t);
   void RenderComb(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderToy(const uint8_t*, int16_t*, size_t);
 
+  template<bool kSync>
   void RenderDigitalFilter(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderVosim(const uint8_t*, int16_t*, size_t);
   void RenderVowel(const uint8_t*, int16_t*, size_t);
   void RenderVowelFof(const uint8_t*, int16_t*, size_t);
 
+  template<bool kSync>
   void RenderHarmonics(const uint8_t*, int16_t*, size_t);
 
+  template<bool kSync>
   void RenderFm(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderFeedbackFm(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderChaoticFeedbackFm(const uint8_t*, int16_t*, size_t);
   
   void RenderStruckBell(const uint8_t*, int16_t*, size_t);
@@ -311,13 +368,17 @@ class DigitalOscillator {
   void RenderBlown(const uint8_t*, int16_t*, size_t);
   void RenderFluted(const uint8_t*, int16_t*, size_t);
 
+  template<bool kSync>
   void RenderWavetables(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderWaveMap(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderWaveLine(const uint8_t*, int16_t*, size_t);
   void RenderWaveParaphonic(const uint8_t*, int16_t*, size_t);
   
   void RenderTwinPeaksNoise(const uint8_t*, int16_t*, size_t);
   void RenderFilteredNoise(const uint8_t*, int16_t*, size_t);
+  template<bool kSync>
   void RenderClockedNoise(const uint8_t*, int16_t*, size_t);
   void RenderGranularCloud(const uint8_t*, int16_t*, size_t);
   void RenderParticleNoise(const uint8_t*, int16_t*, size_t);
@@ -332,6 +393,9 @@ class DigitalOscillator {
   
   uint32_t ComputePhaseIncrement(int16_t midi_pitch);
   uint32_t ComputeDelay(int16_t midi_pitch);
+
+  // Outside the int16_t range: no increment computed yet.
+  static const int32_t kNoPitch = -65536;
   int16_t InterpolateFormantParameter(
       const int16_t table[][kNumFormants][kNumFormants],
       int16_t x,
@@ -342,6 +406,12 @@ class DigitalOscillator {
   uint32_t phase_increment_;
   uint32_t delay_;
 
+  // phase_increment_ and delay_ for increment_pitch_. Some renderers scale
+  // phase_increment_ in place, so Render() restores it from here.
+  int32_t increment_pitch_;
+  uint32_t pitch_phase_increment_;
+  uint32_t pitch_delay_;
+
   int16_t parameter_[2];
   int16_t previous_parameter_[2];
   int32_t smoothed_parameter_;
@@ -351,6 +421,7 @@ class DigitalOscillator {
   
   bool init_;
   bool strike_;
+  bool reduced_partials_;
 
   DigitalOscillatorShape shape_;
   DigitalOscillatorShape previous_shape_;
@@ -359,21 +430,10 @@ class DigitalOscillator {
   Excitation pulse_[4];
   Svf svf_[3];
   
-  union {
-    int16_t comb[kCombDelayLength];
-    int16_t ks[1025 * 4];
-    struct {
-      int8_t bridge[kWGBridgeLength];
-      int8_t neck[kWGNeckLength];
-    } bowed;
-    int16_t bore[kWGBoreLength];
-    struct {
-      int8_t jet[kWGJetLength];
-      int8_t bore[kWGFBoreLength];
-    } fluted;
-  } delay_lines_;
+  DigitalOscillatorDelayLines* delay_lines_;
   
   static RenderFn fn_table_[];
+  static RenderFn no_sync_fn_table_[];
   
   DISALLOW_COPY_AND_ASSIGN(DigitalOscillator);
 };
@@ -58,9 +58,9 @@ class Envelope {
     return static_cast<EnvelopeSegment>(segment_);
   }
 
-  inline void Update(int32_t a, int32_t d, float rate_scale = 1.0f) {
-    increment_[ENV_SEGMENT_ATTACK] = (uint32_t)(lut_env_portamento_increments[a] * rate_scale);
-    increment_[ENV_SEGMENT_DECAY] = (uint32_t)(lut_env_portamento_increments[d] * rate_scale);
+  inline void Update(int32_t a, int32_t d) {
+    increment_[ENV_SEGMENT_ATTACK] = lut_env_portamento_increments[a];
+    increment_[ENV_SEGMENT_DECAY] = lut_env_portamento_increments[d];
   }
   
   inline void Trigger(EnvelopeSegment segment) {
@@ -80,7 +80,28 @@ class MacroOscillator {
   inline void Strike() {
     digital_oscillator_.Strike();
   }
+
+  // Storage for the digital engines' delay lines; see
+  // DigitalOscillator::set_delay_lines.
+  inline void set_delay_lines(DigitalOscillatorDelayLines* delay_lines) {
+    digital_oscillator_.set_delay_lines(delay_lines);
+  }
+
+  inline void set_reduced_partials(bool reduced) {
+    digital_oscillator_.set_reduced_partials(reduced);
+  }
+
+  static inline size_t DelayLinesSize(MacroOscillatorShape shape) {
+    if (shape < MACRO_OSC_SHAPE_TRIPLE_RING_MOD) {
+      return 0;
+    }
+    return DigitalOscillator::DelayLinesSize(
+        static_cast<DigitalOscillatorShape>(
+            shape - MACRO_OSC_SHAPE_TRIPLE_RING_MOD));
+  }
   
+  // sync_buffer may be NULL for no hard sync (the oscillators then skip the
+  // per-sample reset test). Internal sync between oscillators is unaffected.
   void Render(const uint8_t* sync_buffer, int16_t* buffer, size_t size);
   
  private:
@@ -99,8 +120,8 @@ class MacroOscillator {
   int16_t parameter_[2];
   int16_t previous_parameter_[2];
   int16_t pitch_;
-  uint8_t sync_buffer_[24];
-  int16_t temp_buffer_[24];
+  uint8_t sync_buffer_[kMaxBlockSize];
+  int16_t temp_buffer_[kMaxBlockSize];
   int32_t lp_state_;
   
   AnalogOscillator analog_oscillator_[3];
@@ -41,143 +41,6 @@ const char* string_table[] = {
   str_dummy,
 };
 
-const uint16_t lut_resonator_coefficient[] = {
-   65535,  65535,  65535,  65535,
-   65535,  65535,  65535,  65535,
-   65535,  65535,  65535,  65535,
-   65535,  65535,  65535,  65535,
-   65535,  65535,  65535,  65535,
-   65535,  65535,  65535,  65535,
-   65535,  65535,  65535,  65535,
-   65535,  65534,  65534,  65534,
-   65534,  65534,  65534,  65533,
-   65533,  65533,  65532,  65532,
-   65532,  65531,  65531,  65530,
-   65529,  65529,  65528,  65527,
-   65526,  65525,  65523,  65522,
-   65520,  65518,  65516,  65514,
-   65511,  65508,  65505,  65501,
-   65497,  65492,  65487,  65481,
-   65475,  65467,  65459,  65449,
-   65439,  65427,  65414,  65399,
-   65382,  65363,  65342,  65318,
-   65292,  65262,  65228,  65191,
-   65149,  65101,  65048,  64988,
-   64922,  64847,  64762,  64668,
-   64562,  64443,  64310,  64160,
-   63992,  63804,  63593,  63356,
-   63091,  62794,  62461,  62088,
-   61670,  61202,  60677,  60091,
-   59435,  58701,  57881,  56964,
-   55941,  54799,  53526,  52107,
-   50528,  48773,  46824,  44662,
-   42268,  39623,  36704,  33492,
-   29966,  26107,  21898,  17325,
-   12380,   7061,   1374,      0,
-       0,
-};
-const uint16_t lut_resonator_scale[] = {
-       1,      1,      1,      1,
-       1,      1,      1,      1,
-       1,      1,      1,      1,
-       1,      1,      1,      1,
-       1,      1,      1,      1,
-       1,      2,      2,      2,
-       2,      2,      3,      3,
-       3,      4,      4,      4,
-       5,      5,      6,      6,
-       7,      8,      8,      9,
-      10,     11,     12,     13,
-      14,     16,     17,     19,
-      20,     22,     24,     27,
-      29,     32,     35,     38,
-      41,     45,     49,     54,
-      58,     64,     70,     76,
-      83,     90,     98,    107,
-     117,    128,    139,    152,
-     166,    181,    197,    215,
-     234,    255,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,    256,    256,    256,
-     256,
-};
-const uint16_t lut_svf_cutoff[] = {
-      17,     18,     19,     20,
-      22,     23,     24,     26,
-      27,     29,     31,     33,
-      35,     37,     39,     41,
-      44,     46,     49,     52,
-      55,     58,     62,     66,
-      70,     74,     78,     83,
-      88,     93,     99,    105,
-     111,    117,    124,    132,
-     140,    148,    157,    166,
-     176,    187,    198,    210,
-     222,    235,    249,    264,
-     280,    297,    314,    333,
-     353,    374,    396,    420,
-     445,    471,    499,    529,
-     561,    594,    629,    667,
-     706,    748,    793,    840,
-     890,    943,    999,   1059,
-    1122,   1188,   1259,   1334,
-    1413,   1497,   1586,   1681,
-    1781,   1886,   1999,   2117,
-    2243,   2377,   2518,   2668,
-    2826,   2994,   3172,   3361,
-    3560,   3772,   3996,   4233,
-    4485,   4751,   5033,   5332,
-    5648,   5983,   6337,   6713,
-    7111,   7532,   7978,   8449,
-    8949,   9477,  10037,  10628,
-   11254,  11916,  12616,  13356,
-   14138,  14964,  15837,  16758,
-   17730,  18756,  19837,  20975,
-   22174,  23435,  24761,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,  25078,  25078,  25078,
-   25078,
-};
 const uint16_t lut_svf_damp[] = {
    65534,  49213,  46125,  44055,
    42453,  41129,  39991,  38988,
@@ -443,263 +306,6 @@ const uint16_t lut_granular_envelope[] = {
        0,      0,      0,      0,
        0,
 };
-const uint16_t lut_granular_envelope_rate[] = {
-    2048,   2070,   2092,   2115,
-    2138,   2161,   2185,   2209,
-    2233,   2257,   2282,   2307,
-    2332,   2357,   2383,   2409,
-    2435,   2462,   2488,   2515,
-    2543,   2571,   2599,   2627,
-    2655,   2684,   2714,   2743,
-    2773,   2803,   2834,   2865,
-    2896,   2927,   2959,   2991,
-    3024,   3057,   3090,   3124,
-    3158,   3192,   3227,   3262,
-    3298,   3334,   3370,   3407,
-    3444,   3481,   3519,   3558,
-    3596,   3635,   3675,   3715,
-    3756,   3796,   3838,   3880,
-    3922,   3965,   4008,   4051,
-    4096,   4140,   4185,   4231,
-    4277,   4323,   4371,   4418,
-    4466,   4515,   4564,   4614,
-    4664,   4715,   4766,   4818,
-    4870,   4924,   4977,   5031,
-    5086,   5142,   5198,   5254,
-    5311,   5369,   5428,   5487,
-    5547,   5607,   5668,   5730,
-    5792,   5855,   5919,   5983,
-    6049,   6114,   6181,   6248,
-    6316,   6385,   6455,   6525,
-    6596,   6668,   6741,   6814,
-    6888,   6963,   7039,   7116,
-    7193,   7271,   7351,   7431,
-    7512,   7593,   7676,   7760,
-    7844,   7930,   8016,   8103,
-    8192,   8281,   8371,   8462,
-    8554,   8647,   8742,   8837,
-    8933,   9030,   9129,   9228,
-    9328,   9430,   9533,   9637,
-    9741,   9848,   9955,  10063,
-   10173,  10284,  10396,  10509,
-   10623,  10739,  10856,  10974,
-   11094,  11214,  11336,  11460,
-   11585,  11711,  11838,  11967,
-   12098,  12229,  12363,  12497,
-   12633,  12771,  12910,  13051,
-   13193,  13336,  13482,  13628,
-   13777,  13927,  14078,  14232,
-   14387,  14543,  14702,  14862,
-   15024,  15187,  15353,  15520,
-   15689,  15860,  16032,  16207,
-   16384,  16562,  16742,  16925,
-   17109,  17295,  17484,  17674,
-   17866,  18061,  18258,  18456,
-   18657,  18861,  19066,  19274,
-   19483,  19696,  19910,  20127,
-   20346,  20568,  20792,  21018,
-   21247,  21478,  21712,  21949,
-   22188,  22429,  22673,  22920,
-   23170,  23422,  23677,  23935,
-   24196,  24459,  24726,  24995,
-   25267,  25542,  25820,  26102,
-   26386,  26673,  26964,  27257,
-   27554,  27854,  28157,  28464,
-   28774,  29087,  29404,  29724,
-   30048,  30375,  30706,  31040,
-   31378,  31720,  32065,  32415,
-   32768,
-};
-const uint16_t lut_bowing_envelope[] = {
-       0,     10,     21,     32,
-      43,     54,     65,     76,
-      87,     98,    109,    120,
-     131,    142,    153,    164,
-     175,    185,    196,    207,
-     218,    229,    240,    251,
-     262,    273,    284,    295,
-     306,    317,    328,    339,
-     350,    361,    371,    382,
-     393,    404,    415,    426,
-     437,    448,    459,    470,
-     481,    492,    503,    514,
-     525,    536,    547,    557,
-     568,    579,    590,    601,
-     612,    623,    634,    645,
-     656,    667,    678,    689,
-     700,    711,    722,    733,
-     743,    754,    765,    776,
-     787,    798,    809,    820,
-     831,    842,    853,    864,
-     875,    886,    897,    908,
-     919,    929,    940,    951,
-     962,    973,    984,    995,
-    1006,   1017,   1028,   1039,
-    1050,   1061,   1072,   1083,
-    1094,   1105,   1115,   1126,
-    1137,   1148,   1159,   1170,
-    1181,   1192,   1203,   1214,
-    1225,   1236,   1247,   1258,
-    1269,   1280,   1291,   1301,
-    1312,   1323,   1334,   1345,
-    1356,   1367,   1378,   1389,
-    1400,   1411,   1422,   1433,
-    1444,   1455,   1466,   1477,
-    1487,   1498,   1509,   1520,
-    1531,   1542,   1553,   1564,
-    1575,   1586,   1597,   1608,
-    1619,   1630,   1641,   1652,
-    1663,   1673,   1684,   1695,
-    1706,   1717,   1728,   1739,
-    1750,   1761,   1772,   1783,
-    1794,   1805,   1816,   1827,
-    1838,   1849,   1859,   1870,
-    1881,   1892,   1903,   1914,
-    1925,   1936,   1947,   1958,
-    1969,   1980,   1991,   2002,
-    2013,   2024,   2035,   2045,
-    2056,   2067,   2078,   2089,
-    2100,   2111,   2122,   2133,
-    2144,   2155,   2166,   2177,
-    2188,   2199,   2210,   2221,
-    2231,   2242,   2253,   2264,
-    2275,   2286,   2297,   2308,
-    2319,   2330,   2341,   2352,
-    2363,   2374,   2385,   2396,
-    2406,   2417,   2428,   2439,
-    2450,   2461,   2472,   2483,
-    2494,   2505,   2516,   2527,
-    2538,   2549,   2560,   2571,
-    2582,   2592,   2603,   2614,
-    2625,   2636,   2647,   2658,
-    2669,   2680,   2691,   2702,
-    2713,   2724,   2735,   2746,
-    2757,   2768,   2778,   2789,
-    2800,   2811,   2822,   2833,
-    2844,   2855,   2866,   2877,
-    2888,   2899,   2910,   2921,
-    2932,   2943,   2954,   2964,
-    2975,   2986,   2997,   3008,
-    3019,   3030,   3041,   3052,
-    3063,   3074,   3085,   3096,
-    3107,   3118,   3129,   3140,
-    3150,   3161,   3172,   3183,
-    3194,   3205,   3216,   3227,
-    3238,   3249,   3260,   3271,
-    3282,   3293,   3304,   3315,
-    3326,   3336,   3347,   3358,
-    3369,   3380,   3391,   3402,
-    3413,   3424,   3435,   3446,
-    3457,   3468,   3479,   3490,
-    3501,   3512,   3522,   3533,
-    3544,   3555,   3566,   3577,
-    3588,   3599,   3610,   3621,
-    3632,   3643,   3654,   3665,
-    3676,   3687,   3698,   3708,
-    3719,   3730,   3741,   3752,
-    3763,   3774,   3785,   3796,
-    3807,   3818,   3829,   3840,
-    3851,   3862,   3873,   3884,
-    3894,   3905,   3916,   3927,
-    3938,   3949,   3960,   3971,
-    3982,   3993,   4004,   4015,
-    4026,   4037,   4048,   4059,
-    4070,   4080,   4091,   4102,
-    4113,   4124,   4135,   4146,
-    4157,   4168,   4179,   4190,
-    4201,   4212,   4223,   4234,
-    4245,   4256,   4266,   4277,
-    4288,   4299,   4310,   4321,
-    4332,   4343,   4354,   4365,
-    4376,   4387,   4398,   4409,
-    4420,   4431,   4442,   4452,
-    4463,   4474,   4485,   4496,
-    4507,   4518,   4529,   4540,
-    4551,   4562,   4573,   4584,
-    4595,   4606,   4617,   4628,
-    4638,   4649,   4660,   4671,
-    4682,   4693,   4704,   4715,
-    4726,   4737,   4748,   4759,
-    4770,   4781,   4792,   4803,
-    4813,   4824,   4835,   4846,
-    4857,   4868,   4879,   4890,
-    4901,   4912,   4923,   4934,
-    4945,   4956,   4967,   4978,
-    4989,   4999,   5010,   5021,
-    5032,   5043,   5054,   5065,
-    5076,   5087,   5098,   5109,
-    5120,   5131,   5142,   5153,
-    5164,   5175,   5185,   5196,
-    5207,   5218,   5229,   5240,
-    5251,   5262,   5273,   5284,
-    5295,   5306,   5317,   5328,
-    5339,   5350,   5361,   5371,
-    5382,   5393,   5404,   5415,
-    5426,   5437,   5448,   5459,
-    5470,   5481,   5492,   5503,
-    5514,   5525,   5536,   5547,
-    5557,   5568,   5579,   5590,
-    5601,   5612,   5623,   5634,
-    5645,   5656,   5667,   5678,
-    5689,   5700,   5711,   5722,
-    5733,   5743,   5754,   5765,
-    5776,   5787,   5798,   5809,
-    5820,   5831,   5842,   5853,
-    5864,   5875,   5886,   5897,
-    5908,   5919,   5929,   5940,
-    5951,   5962,   5973,   5984,
-    5995,   6006,   6017,   6028,
-    6039,   6050,   6061,   6072,
-    6083,   6094,   6105,   6115,
-    6126,   6137,   6148,   6159,
-    6170,   6181,   6192,   6203,
-    6214,   6225,   6236,   6247,
-    6258,   6269,   6280,   6291,
-    6301,   6312,   6323,   6334,
-    6345,   6356,   6367,   6378,
-    6389,   6400,   6411,   6422,
-    6433,   6444,   6455,   6466,
-    6477,   6487,   6498,   6509,
-    6520,   6531,   6542,   6553,
-    6553,   6542,   6531,   6520,
-    6509,   6498,   6487,   6476,
-    6465,   6454,   6443,   6432,
-    6421,   6410,   6399,   6388,
-    6377,   6366,   6355,   6344,
-    6333,   6322,   6311,   6300,
-    6289,   6278,   6267,   6256,
-    6245,   6234,   6223,   6212,
-    6201,   6190,   6179,   6168,
-    6157,   6146,   6135,   6124,
-    6113,   6102,   6090,   6079,
-    6068,   6057,   6046,   6035,
-    6024,   6013,   6002,   5991,
-    5980,   5969,   5958,   5947,
-    5936,   5925,   5914,   5903,
-    5892,   5881,   5870,   5859,
-    5848,   5837,   5826,   5815,
-    5804,   5793,   5782,   5771,
-    5760,   5749,   5738,   5727,
-    5716,   5705,   5694,   5683,
-    5672,   5661,   5650,   5639,
-    5628,   5617,   5606,   5595,
-    5584,   5573,   5562,   5551,
-    5540,   5529,   5518,   5507,
-    5496,   5485,   5474,   5463,
-    5452,   5441,   5430,   5419,
-    5408,   5397,   5386,   5375,
-    5364,   5353,   5342,   5330,
-    5319,   5308,   5297,   5286,
-    5275,   5264,   5253,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-    5242,   5242,   5242,   5242,
-};
 const uint16_t lut_bowing_friction[] = {
    32768,  32768,  32768,  32768,
    32768,  32768,  32768,  32768,
@@ -767,140 +373,6 @@ const uint16_t lut_bowing_friction[] = {
       67,     66,     66,     65,
       64,
 };
-const uint16_t lut_blowing_envelope[] = {
-       0,    178,    357,    536,
-     715,    894,   1073,   1252,
-    1431,   1610,   1789,   1968,
-    2147,   2326,   2505,   2684,
-    2863,   3042,   3221,   3400,
-    3579,   3758,   3937,   4116,
-    4295,   4474,   4653,   4832,
-    5011,   5190,   5369,   5548,
-    5727,   5906,   6085,   6264,
-    6443,   6622,   6801,   6980,
-    7159,   7338,   7517,   7696,
-    7875,   8054,   8233,   8412,
-    8591,   8770,   8949,   9128,
-    9307,   9486,   9665,   9844,
-   10023,  10202,  10381,  10560,
-   10739,  10918,  11097,  11276,
-   11455,  11634,  11813,  11991,
-   12170,  12349,  12528,  12707,
-   12886,  13065,  13244,  13423,
-   13602,  13781,  13960,  14139,
-   14318,  14497,  14676,  14855,
-   15034,  15213,  15392,  15571,
-   15750,  15929,  16108,  16287,
-   16466,  16645,  16824,  17003,
-   17182,  17361,  17540,  17719,
-   17898,  18077,  18256,  18435,
-   18614,  18793,  18972,  19151,
-   19330,  19509,  19688,  19867,
-   20046,  20225,  20404,  20583,
-   20762,  20941,  21120,  21299,
-   21299,  21281,  21263,  21245,
-   21227,  21210,  21192,  21174,
-   21156,  21138,  21120,  21103,
-   21085,  21067,  21049,  21031,
-   21014,  20996,  20978,  20960,
-   20942,  20924,  20907,  20889,
-   20871,  20853,  20835,  20817,
-   20800,  20782,  20764,  20746,
-   20728,  20711,  20693,  20675,
-   20657,  20639,  20621,  20604,
-   20586,  20568,  20550,  20532,
-   20514,  20497,  20479,  20461,
-   20443,  20425,  20408,  20390,
-   20372,  20354,  20336,  20318,
-   20301,  20283,  20265,  20247,
-   20229,  20211,  20194,  20176,
-   20158,  20140,  20122,  20105,
-   20087,  20069,  20051,  20033,
-   20015,  19998,  19980,  19962,
-   19944,  19926,  19908,  19891,
-   19873,  19855,  19837,  19819,
-   19802,  19784,  19766,  19748,
-   19730,  19712,  19695,  19677,
-   19659,  19641,  19623,  19605,
-   19588,  19570,  19552,  19534,
-   19516,  19499,  19481,  19463,
-   19445,  19427,  19409,  19392,
-   19374,  19356,  19338,  19320,
-   19302,  19285,  19267,  19249,
-   19231,  19213,  19196,  19178,
-   19160,  19142,  19124,  19106,
-   19089,  19071,  19053,  19035,
-   19017,  18999,  18982,  18964,
-   18946,  18928,  18910,  18893,
-   18875,  18857,  18839,  18821,
-   18803,  18786,  18768,  18750,
-   18732,  18714,  18696,  18679,
-   18661,  18643,  18625,  18607,
-   18590,  18572,  18554,  18536,
-   18518,  18500,  18483,  18465,
-   18447,  18429,  18411,  18393,
-   18376,  18358,  18340,  18322,
-   18304,  18287,  18269,  18251,
-   18233,  18215,  18197,  18180,
-   18162,  18144,  18126,  18108,
-   18090,  18073,  18055,  18037,
-   18019,  18001,  17984,  17966,
-   17948,  17930,  17912,  17894,
-   17877,  17859,  17841,  17823,
-   17805,  17787,  17770,  17752,
-   17734,  17716,  17698,  17681,
-   17663,  17645,  17627,  17609,
-   17591,  17574,  17556,  17538,
-   17520,  17502,  17484,  17467,
-   17449,  17431,  17413,  17395,
-   17378,  17360,  17342,  17324,
-   17306,  17288,  17271,  17253,
-   17235,  17217,  17199,  17181,
-   17164,  17146,  17128,  17110,
-   17092,  17075,  17057,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-   17039,  17039,  17039,  17039,
-};
-const uint16_t lut_flute_body_filter[] = {
-      30,     32,     34,     36,
-      38,     40,     43,     45,
-      48,     51,     54,     57,
-      60,     64,     68,     72,
-      76,     81,     86,     91,
-      96,    102,    108,    114,
-     121,    129,    136,    144,
-     153,    162,    172,    182,
-     193,    204,    216,    229,
-     243,    258,    273,    289,
-     306,    325,    344,    364,
-     386,    409,    433,    459,
-     487,    516,    546,    579,
-     613,    650,    688,    729,
-     773,    819,    867,    919,
-     974,   1032,   1093,   1158,
-    1227,   1300,   1377,   1459,
-    1546,   1638,   1735,   1839,
-    1948,   2064,   2187,   2317,
-    2454,   2600,   2755,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-    2867,   2867,   2867,   2867,
-};
 const uint16_t lut_fm_frequency_quantizer[] = {
     7168,   7168,   7168,   7360,
     7552,   7744,   7936,   8128,
@@ -1230,94 +702,6 @@ const int16_t* lookup_table_signed_table[] = {
   lut_blowing_jet,
 };
 
-const uint32_t lut_oscillator_increments[] = {
-  594573364, 598881888, 603221633, 607592826,
-  611995694, 616430467, 620897376, 625396654,
-  629928536, 634493258, 639091058, 643722175,
-  648386851, 653085330, 657817855, 662584675,
-  667386036, 672222191, 677093390, 681999888,
-  686941940, 691919804, 696933740, 701984010,
-  707070875, 712194602, 717355458, 722553711,
-  727789633, 733063497, 738375577, 743726151,
-  749115497, 754543897, 760011633, 765518991,
-  771066257, 776653721, 782281674, 787950409,
-  793660223, 799411412, 805204277, 811039119,
-  816916243, 822835954, 828798563, 834804379,
-  840853716, 846946888, 853084215, 859266014,
-  865492610, 871764326, 878081490, 884444431,
-  890853479, 897308971, 903811242, 910360631,
-  916957479, 923602131, 930294933, 937036233,
-  943826384, 950665739, 957554655, 964493491,
-  971482608, 978522372, 985613148, 992755307,
-  999949221, 1007195266, 1014493818, 1021845258,
-  1029249970, 1036708340, 1044220756, 1051787610,
-  1059409296, 1067086213, 1074818759, 1082607339,
-  1090452358, 1098354226, 1106313353, 1114330156,
-  1122405051, 1130538461, 1138730809, 1146982522,
-  1155294030, 1163665767, 1172098168, 1180591675,
-  1189146729,
-};
-const uint32_t lut_oscillator_delays[] = {
-  1939073583, 1925123345, 1911273470, 1897523234,
-  1883871922, 1870318821, 1856863224, 1843504431,
-  1830241745, 1817074474, 1804001933, 1791023438,
-  1778138315, 1765345891, 1752645499, 1740036478,
-  1727518169, 1715089920, 1702751084, 1690501017,
-  1678339080, 1666264640, 1654277066, 1642375735,
-  1630560024, 1618829320, 1607183009, 1595620485,
-  1584141146, 1572744391, 1561429629, 1550196268,
-  1539043722, 1527971412, 1516978758, 1506065189,
-  1495230135, 1484473032, 1473793318, 1463190437,
-  1452663836, 1442212966, 1431837283, 1421536245,
-  1411309316, 1401155962, 1391075655, 1381067868,
-  1371132079, 1361267772, 1351474431, 1341751546,
-  1332098611, 1322515121, 1313000577, 1303554484,
-  1294176349, 1284865683, 1275622000, 1266444818,
-  1257333660, 1248288051, 1239307518, 1230391593,
-  1221539812, 1212751713, 1204026838, 1195364733,
-  1186764945, 1178227026, 1169750531, 1161335019,
-  1152980050, 1144685189, 1136450004, 1128274065,
-  1120156946, 1112098224, 1104097479, 1096154293,
-  1088268252, 1080438946, 1072665967, 1064948908,
-  1057287368, 1049680947, 1042129249, 1034631880,
-  1027188449, 1019798568, 1012461852, 1005177918,
-  997946388, 990766882, 983639028, 976562454,
-  969536791,
-};
-const uint32_t lut_env_portamento_increments[] = {
-  1431655765, 1208633567, 1025339217, 873854034,
-  747996982, 642910145, 554750639, 480459775,
-  417588783, 364166300, 318596895, 279582889,
-  246063710, 217168604, 192179528, 170501890,
-  151641346, 135185326, 120788231, 108159539,
-  97054201, 87264844, 78615425, 70956050,
-  64158714, 58113796, 52727166, 47917783,
-  43615697, 39760385, 36299356, 33186980,
-  30383504, 27854220, 25568762, 23500507,
-  21626072, 19924877, 18378778, 16971748,
-  15689604, 14519780, 13451115, 12473688,
-  11578663, 10758156, 10005128, 9313280,
-  8676970, 8091136, 7551232, 7053169,
-  6593263, 6168194, 5774964, 5410864,
-  5073442, 4760475, 4469950, 4200037,
-  3949073, 3715547, 3498079, 3295415,
-  3106409, 2930012, 2765269, 2611303,
-  2467313, 2332562, 2206377, 2088136,
-  1977272, 1873260, 1775618, 1683902,
-  1597702, 1516641, 1440370, 1368566,
-  1300932, 1237191, 1177088, 1120388,
-  1066869, 1016330, 968580, 923445,
-  880761, 840376, 802150, 765951,
-  731657, 699152, 668331, 639094,
-  611349, 585008, 559991, 536221,
-  513628, 492146, 471711, 452267,
-  433757, 416131, 399341, 383341,
-  368089, 353545, 339672, 326434,
-  313798, 301733, 290209, 279199,
-  268677, 258617, 248997, 239795,
-  230990, 222562, 214494, 206767,
-  199365, 192272, 185474, 178956,
-};
 
 
 const uint32_t* lookup_table_hr_table[] = {
@@ -36,6 +36,9 @@
 
 #include "stmlib/stmlib.h"
 
+// Tables that depend on the sample rate, generated by scripts/gen_tables.py
+#include "braids/sample_rate_tables.h"
+
 
 
 namespace braids {
@@ -52,31 +55,27 @@ extern const uint32_t* lookup_table_hr_table[];
 
 extern const int16_t* waveform_table[];
 
+#ifdef BRAIDS_TABLES_INT8
+// 8-bit copies emitted by scripts/pack_tables.py --int8. Entries that did not
+// meet the quality bar are NULL.
+extern const uint8_t* waveform_table_u8[];
+#endif  // BRAIDS_TABLES_INT8
+
 extern const int16_t* waveshaper_table[];
 
 extern const uint8_t* wt_table[];
 
 extern const uint16_t* char_table[];
 
-extern const uint16_t lut_resonator_coefficient[];
-extern const uint16_t lut_resonator_scale[];
-extern const uint16_t lut_svf_cutoff[];
 extern const uint16_t lut_svf_damp[];
 extern const uint16_t lut_svf_scale[];
 extern const uint16_t lut_granular_envelope[];
-extern const uint16_t lut_granular_envelope_rate[];
-extern const uint16_t lut_bowing_envelope[];
 extern const uint16_t lut_bowing_friction[];
-extern const uint16_t lut_blowing_envelope[];
-extern const uint16_t lut_flute_body_filter[];
 extern const uint16_t lut_fm_frequency_quantizer[];
 extern const uint16_t lut_vco_detune[];
 extern const uint16_t lut_bell[];
 extern const uint16_t lut_env_expo[];
 extern const int16_t lut_blowing_jet[];
-extern const uint32_t lut_oscillator_increments[];
-extern const uint32_t lut_oscillator_delays[];
-extern const uint32_t lut_env_portamento_increments[];
 extern const int16_t wav_formant_sine[];
 extern const int16_t wav_formant_square[];
 extern const int16_t wav_sine[];
@@ -105,11 +104,8 @@ extern const uint8_t wt_code[];
 extern const uint16_t chr_characters[];
 #define STR_DUMMY 0  // dummy
 #define LUT_RESONATOR_COEFFICIENT 0
-#define LUT_RESONATOR_COEFFICIENT_SIZE 129
 #define LUT_RESONATOR_SCALE 1
-#define LUT_RESONATOR_SCALE_SIZE 129
 #define LUT_SVF_CUTOFF 2
-#define LUT_SVF_CUTOFF_SIZE 257
 #define LUT_SVF_DAMP 3
 #define LUT_SVF_DAMP_SIZE 257
 #define LUT_SVF_SCALE 4
@@ -117,15 +113,11 @@ extern const uint16_t chr_characters[];
 #define LUT_GRANULAR_ENVELOPE 5
 #define LUT_GRANULAR_ENVELOPE_SIZE 513
 #define LUT_GRANULAR_ENVELOPE_RATE 6
-#define LUT_GRANULAR_ENVELOPE_RATE_SIZE 257
 #define LUT_BOWING_ENVELOPE 7
-#define LUT_BOWING_ENVELOPE_SIZE 752
 #define LUT_BOWING_FRICTION 8
 #define LUT_BOWING_FRICTION_SIZE 257
 #define LUT_BLOWING_ENVELOPE 9
-#define LUT_BLOWING_ENVELOPE_SIZE 392
 #define LUT_FLUTE_BODY_FILTER 10
-#define LUT_FLUTE_BODY_FILTER_SIZE 128
 #define LUT_FM_FREQUENCY_QUANTIZER 11
 #define LUT_FM_FREQUENCY_QUANTIZER_SIZE 129
 #define LUT_VCO_DETUNE 12
@@ -137,11 +129,8 @@ extern const uint16_t chr_characters[];
 #define LUT_BLOWING_JET 0
 #define LUT_BLOWING_JET_SIZE 257
 #define LUT_OSCILLATOR_INCREMENTS 0
-#define LUT_OSCILLATOR_INCREMENTS_SIZE 97
 #define LUT_OSCILLATOR_DELAYS 1
-#define LUT_OSCILLATOR_DELAYS_SIZE 97
 #define LUT_ENV_PORTAMENTO_INCREMENTS 2
-#define LUT_ENV_PORTAMENTO_INCREMENTS_SIZE 128
 #define WAV_FORMANT_SINE 0
 #define WAV_FORMANT_SINE_SIZE 256
 #define WAV_FORMANT_SQUARE 1
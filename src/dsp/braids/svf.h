@@ -75,6 +75,16 @@ class Svf {
     mode_ = mode;
   }
 
+  // Integrator state, for callers that run the filter on several voices at
+  // once and need to hand the state back and forth.
+  inline int16_t frequency() const { return frequency_; }
+  inline int32_t lp() const { return lp_; }
+  inline int32_t bp() const { return bp_; }
+  inline void set_state(int32_t lp, int32_t bp) {
+    lp_ = lp;
+    bp_ = bp;
+  }
+
   inline int32_t Process(int32_t in) {
     if (dirty_) {
       f_ = stmlib::Interpolate824(lut_svf_cutoff, frequency_ << 17);
@@ -13,70 +13,103 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 #include <math.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /* Include plugin API */
-extern "C" {
-#include <stdint.h>
-
-#define MOVE_PLUGIN_API_VERSION 1
-#define MOVE_SAMPLE_RATE 44100
-#define MOVE_FRAMES_PER_BLOCK 128
-#define MOVE_MIDI_SOURCE_INTERNAL 0
-#define MOVE_MIDI_SOURCE_EXTERNAL 2
-
-typedef struct host_api_v1 {
-    uint32_t api_version;
-    int sample_rate;
-    int frames_per_block;
-    uint8_t *mapped_memory;
-    int audio_out_offset;
-    int audio_in_offset;
-    void (*log)(const char *msg);
-    int (*midi_send_internal)(const uint8_t *msg, int len);
-    int (*midi_send_external)(const uint8_t *msg, int len);
-} host_api_v1_t;
-
-#define MOVE_PLUGIN_API_VERSION_2 2
-
-typedef struct plugin_api_v2 {
-    uint32_t api_version;
-    void* (*create_instance)(const char *module_dir, const char *json_defaults);
-    void (*destroy_instance)(void *instance);
-    void (*on_midi)(void *instance, const uint8_t *msg, int len, int source);
-    void (*set_param)(void *instance, const char *key, const char *val);
-    int (*get_param)(void *instance, const char *key, char *buf, int buf_len);
-    int (*get_error)(void *instance, char *buf, int buf_len);
-    void (*render_block)(void *instance, int16_t *out_interleaved_lr, int frames);
-} plugin_api_v2_t;
-
-typedef plugin_api_v2_t* (*move_plugin_init_v2_fn)(const host_api_v1_t *host);
-#define MOVE_PLUGIN_INIT_V2_SYMBOL "move_plugin_init_v2"
-}
+#include "plugin_api_v1.h"
 
 /* Braids engine */
 #include "braids/macro_oscillator.h"
 #include "braids/envelope.h"
 #include "braids/svf.h"
+#include "stmlib/utils/random.h"
 
 /* Constants */
-#define MAX_VOICES 4
+#define MAX_VOICES 16       /* Compile-time voice pool; the playable ceiling is dynamic */
+#define DEFAULT_VOICES 4    /* Ceiling until the current engine's cost is known */
 #define BRAIDS_BLOCK_SIZE 24
+#define FILTER_CONTROL_PERIOD 8  /* Default samples per filter modulation update */
+
+/*
+ * Lanes path oscillator block size. Oscillators always render full blocks of
+ * this size; samples beyond the host block wait in a per-voice FIFO. Sizes
+ * that divide the host block (32, 64) never carry samples over. Some engines
+ * (BELL, DRUM, ...) step internal decays once per block, so 24 - the Braids
+ * module's own block size - keeps their timing.
+ */
+#define OSC_BLOCK_DEFAULT 24
+#define OSC_BLOCK_MAX 64
+
+/*
+ * Dynamic polyphony. The voice ceiling follows a per-engine estimate of the
+ * cost of one voice per block, measured live, so that a full chord stays
+ * inside voice_budget (% of the real-time block).
+ */
+#define VOICE_BUDGET_DEFAULT 50.0f   /* % of real time */
+#define VOICE_COST_MIN_SAMPLES 8     /* Blocks of data before an estimate is trusted */
+#define VOICE_LIMIT_RAISE_BLOCKS 32  /* Min blocks between raising the ceiling (~93ms) */
+#define VOICE_RETIRE_TIME 0.005f     /* Fade time for voices above a lowered ceiling */
+#define VOICE_RETIRE_RATE (1.0f / (VOICE_RETIRE_TIME * 44100.0f))
+
+/*
+ * Silence detection. A voice whose output (before volume) has peaked under
+ * silence_threshold for SILENCE_HOLD samples in a row stops rendering: a
+ * released voice anywhere in its release, a held one only if its engine
+ * dies away after the strike and its attack is over.
+ */
+#define SILENCE_THRESHOLD_DEFAULT -90.0f  /* dBFS, about 1 LSB */
+#define SILENCE_THRESHOLD_MIN -140.0f
+#define SILENCE_THRESHOLD_MAX -40.0f
+#define SILENCE_HOLD 2048                 /* Samples (~46 ms) */
+
+/*
+ * Engine state arena. The digital engines' delay lines (up to 8 KB per voice,
+ * used by COMB, PLUK, BOWD, BLOW and FLUT only) live in one per-instance
+ * block rather than in every voice. With state_arena on, each voice's slot
+ * is only as large as the engine on its side needs. A voice has a slot on
+ * each of its two engine sides, see below.
+ */
+#define CACHE_LINE_SIZE 64
+#define STATE_ARENA_SLOT_MAX \
+    ((sizeof(braids::DigitalOscillatorDelayLines) + CACHE_LINE_SIZE - 1) \
+     & ~(size_t)(CACHE_LINE_SIZE - 1))
+#define STATE_ARENA_SIDE (STATE_ARENA_SLOT_MAX * MAX_VOICES)
 
 /*
- * Pitch correction for 44.1kHz operation.
- * Braids lookup tables are calibrated for 96kHz.
- * Offset = 12 * 128 * log2(96000/44100) = ~1724
+ * Engine switching. Each voice has two oscillators, one per engine "side".
+ * An engine change strikes the new engine on the idle side and the voice
+ * crossfades into it while the old engine plays on, so there is no click
+ * and a voice never renders more than two engines. The new engine's set-up
+ * (clearing its delay line slot, its Init on the first render) is spread
+ * over blocks: at most ENGINE_SWITCH_VOICES sounding voices start their
+ * fade per block. A further change waits until the last fade has finished.
  */
-#define PITCH_CORRECTION 1724
+#define ENGINE_FADE_SHIFT 9         /* Crossfade of 512 samples (~11.6 ms) */
+#define ENGINE_FADE_SAMPLES (1 << ENGINE_FADE_SHIFT)
+#define ENGINE_SWITCH_VOICES 4
+
+/* One-pole smoothing of continuous params on the audio thread */
+#define PARAM_SMOOTH_TIME 0.010f     /* Time constant, seconds */
 
 /*
- * Envelope rate scaling for 44.1kHz operation.
- * Braids envelope LUTs are calibrated for 96kHz.
- * Scale factor = 44100/96000 ≈ 0.459375
+ * Quality tiers. High renders the engines that alias the most an octave down
+ * at twice the length and decimates them back (halfband.h); eco runs the
+ * filter at control rate and the additive engines with fewer partials. With
+ * quality_budget set, the tier in use steps down while the render load is
+ * over it, and back up (never past quality) once there is room for it.
  */
-#define ENV_RATE_SCALE (44100.0f / 96000.0f)
+#define QUALITY_ECO_FILTER_PERIOD 32  /* Lanes path: samples per filter update at eco */
+#define QUALITY_OVERSAMPLE_MIN_PITCH (12 << 7)  /* Lower notes cannot go an octave down */
+#define QUALITY_STEP_BLOCKS 64        /* Min blocks between steps (~186ms) */
+#define QUALITY_RAISE_BLOCKS 345      /* Room needed this long to step up (~1s) */
+#define QUALITY_RAISE_HEADROOM 0.5f   /* Room: load under this share of the budget */
 
 /* =====================================================================
  * Simple ADSR envelope - replaces Braids' AR-only envelope
@@ -101,32 +134,82 @@ struct SimpleADSR {
         release_rate = time_to_rate(r);
     }
 
+    /* Take the rates computed by another envelope's set_params */
+    void copy_rates(const SimpleADSR &other) {
+        attack_rate = other.attack_rate;
+        decay_rate = other.decay_rate;
+        sustain_level = other.sustain_level;
+        release_rate = other.release_rate;
+    }
+
     void gate_on() { stage = ATTACK; }
     void gate_off() { if (stage != IDLE) stage = RELEASE; }
     bool is_active() const { return stage != IDLE; }
 
-    float process() {
-        switch (stage) {
-            case ATTACK:
-                level += attack_rate;
-                if (level >= 1.0f) { level = 1.0f; stage = DECAY; }
-                break;
-            case DECAY:
-                level -= decay_rate;
-                if (level <= sustain_level) { level = sustain_level; stage = SUSTAIN; }
-                break;
-            case SUSTAIN:
-                level = sustain_level;
-                break;
-            case RELEASE:
-                level -= release_rate;
-                if (level <= 0.0f) { level = 0.0f; stage = IDLE; }
-                break;
-            case IDLE:
-                level = 0.0f;
-                break;
-        }
-        return level;
+    /* Whole samples until a ramp of rate covers distance (the last one lands on it) */
+    static int steps(float distance, float rate) {
+        float n = ceilf(distance / rate);
+        if (!(n >= 1.0f)) return 1;
+        return n < (float)(1 << 30) ? (int)n : 1 << 30;
+    }
+
+    /*
+     * Write the next n levels to out, one stage at a time rather than one
+     * sample at a time: each segment's length is worked out up front and
+     * filled without branching, and the sample a stage ends on is set to
+     * its target exactly, so transitions land where a per-sample linear
+     * ADSR would put them. Returns: the offset of the sample the envelope
+     * went idle on (0 if it already was), or n if it is still running.
+     */
+    int render(float *out, int n) {
+        int idle_at = n;
+        int i = 0;
+        while (i < n) {
+            int left = n - i;
+            int len;
+            switch (stage) {
+                case ATTACK: {
+                    int k = steps(1.0f - level, attack_rate);
+                    len = k < left ? k : left;
+                    for (int j = 0; j < len; j++) {
+                        out[i + j] = fminf(level + (float)(j + 1) * attack_rate, 1.0f);
+                    }
+                    if (len == k) { out[i + len - 1] = 1.0f; stage = DECAY; }
+                    break;
+                }
+                case DECAY: {
+                    int k = steps(level - sustain_level, decay_rate);
+                    len = k < left ? k : left;
+                    for (int j = 0; j < len; j++) {
+                        out[i + j] = fmaxf(level - (float)(j + 1) * decay_rate, sustain_level);
+                    }
+                    if (len == k) { out[i + len - 1] = sustain_level; stage = SUSTAIN; }
+                    break;
+                }
+                case RELEASE: {
+                    int k = steps(level, release_rate);
+                    len = k < left ? k : left;
+                    for (int j = 0; j < len; j++) {
+                        out[i + j] = fmaxf(level - (float)(j + 1) * release_rate, 0.0f);
+                    }
+                    if (len == k) { out[i + len - 1] = 0.0f; stage = IDLE; idle_at = i + len - 1; }
+                    break;
+                }
+                case SUSTAIN:
+                    len = left;
+                    for (int j = 0; j < len; j++) out[i + j] = sustain_level;
+                    break;
+                case IDLE:
+                default:
+                    if (idle_at == n) idle_at = i;
+                    len = left;
+                    for (int j = 0; j < len; j++) out[i + j] = 0.0f;
+                    break;
+            }
+            i += len;
+            level = out[i - 1];
+        }
+        return idle_at;
     }
 };
 
@@ -149,7 +232,7 @@ static const char* g_shape_names[] = {
 #define NUM_SHAPES ((int)braids::MACRO_OSC_SHAPE_LAST_ACCESSIBLE_FROM_META + 1)
 
 /* Preset system */
-#define MAX_PRESETS 64
+#define PRESET_LIBRARY_INITIAL_CAPACITY 16
 
 /* Host API reference */
 static const host_api_v1_t *g_host = NULL;
@@ -157,6 +240,70 @@ static const host_api_v1_t *g_host = NULL;
 /* Parameter helper */
 #include "param_helper.h"
 
+/* Render-time instrumentation (compiled out with -DBRAIDS_PERF_STATS=0) */
+#include "perf_stats.h"
+
+/* Voice-parallel envelope / SVF / mix stage */
+#include "voice_lanes.h"
+
+/* Control -> audio thread parameter messages */
+#include "param_queue.h"
+
+/* Shared worker threads for parallel voice rendering */
+#include "worker_pool.h"
+
+/* Detuned saw / square stack for the analog engines */
+#include "unison_lanes.h"
+
+/* Lock-free log lines, drained to the host outside the audio path */
+#include "log_ring.h"
+
+/* 2x decimation for the high quality tier */
+#include "halfband.h"
+
+/* Debug check for blocking calls on the audio path (-DBRAIDS_RT_WATCHDOG=1) */
+#include "rt_watchdog.h"
+
+#define VOICE_LANE_GROUPS ((MAX_VOICES + VOICE_LANE_WIDTH - 1) / VOICE_LANE_WIDTH)
+
+/* Post-oscillator render paths */
+enum RenderMode {
+    RENDER_MODE_LANES = 0,  /* All voices at once through voice_lanes.h */
+    RENDER_MODE_SCALAR,     /* Original per-voice, per-sample loop (reference) */
+};
+
+/* Render quality (quality param) */
+enum RenderQuality {
+    QUALITY_ECO = 0,        /* Control-rate filter, fewer additive partials */
+    QUALITY_NORMAL,         /* The engines as Braids renders them */
+    QUALITY_HIGH,           /* Aliasing engines oversampled 2x */
+};
+
+static const char *g_quality_names[] = { "eco", "normal", "high" };
+
+/* Where voice jobs run (threading param) */
+enum ThreadingMode {
+    THREADING_OFF = 0,      /* All voices on the host audio thread */
+    THREADING_SYNC,         /* Voices spread over the worker pool, mixed this block */
+    THREADING_PIPELINED,    /* Workers render the next block; one block of latency */
+};
+
+/* Where in the next block queued MIDI takes effect (midi_timing param) */
+enum MidiTiming {
+    MIDI_TIMING_BLOCK = 0,  /* Applied on arrival: at the next block boundary */
+    MIDI_TIMING_SPREAD,     /* Queued; spread over the block in arrival order */
+    MIDI_TIMING_CLOCK,      /* Queued; placed by arrival time, one block late */
+};
+
+#define MIDI_EVENT_MAX 64   /* MIDI queued for the next render_block */
+
+typedef struct {
+    uint64_t time;          /* perf_now() on arrival */
+    int frame;              /* Offset into the block, set by render_block */
+    uint8_t msg[3];
+    uint8_t len;
+} MidiEvent;
+
 /* Parameter indices for our values array */
 enum BraidsParam {
     PARAM_ENGINE = 0,
@@ -175,15 +322,130 @@ enum BraidsParam {
     PARAM_F_SUSTAIN,
     PARAM_F_RELEASE,
     PARAM_VOLUME,
+    PARAM_UNISON,
+    PARAM_UNISON_SPREAD,
+    PARAM_GLIDE,
     PARAM_COUNT
 };
 
+/* New instances, and what presets leave out (scripts/pack_presets.py reads these) */
+static const float g_param_defaults[PARAM_COUNT] = {
+    0.0f,   /* PARAM_ENGINE */
+    0.5f,   /* PARAM_TIMBRE */
+    0.5f,   /* PARAM_COLOR */
+    0.0f,   /* PARAM_ATTACK */
+    0.5f,   /* PARAM_DECAY */
+    1.0f,   /* PARAM_SUSTAIN */
+    0.3f,   /* PARAM_RELEASE */
+    0.0f,   /* PARAM_FM */
+    1.0f,   /* PARAM_CUTOFF */
+    0.0f,   /* PARAM_RESONANCE */
+    0.0f,   /* PARAM_FILT_ENV */
+    0.0f,   /* PARAM_F_ATTACK */
+    0.3f,   /* PARAM_F_DECAY */
+    0.0f,   /* PARAM_F_SUSTAIN */
+    0.3f,   /* PARAM_F_RELEASE */
+    0.7f,   /* PARAM_VOLUME */
+    1.0f,   /* PARAM_UNISON */
+    0.25f,  /* PARAM_UNISON_SPREAD */
+    0.0f,   /* PARAM_GLIDE */
+};
+
+/* Dirty bits: one per BraidsParam, set when the audio-side value changes */
+#define PARAM_BIT(p) (1u << (p))
+#define AMP_ENV_BITS (PARAM_BIT(PARAM_ATTACK) | PARAM_BIT(PARAM_DECAY) \
+                      | PARAM_BIT(PARAM_SUSTAIN) | PARAM_BIT(PARAM_RELEASE))
+#define FILT_ENV_BITS (PARAM_BIT(PARAM_F_ATTACK) | PARAM_BIT(PARAM_F_DECAY) \
+                       | PARAM_BIT(PARAM_F_SUSTAIN) | PARAM_BIT(PARAM_F_RELEASE))
+#define ALL_PARAM_BITS ((uint32_t)((1ull << PARAM_COUNT) - 1))
+static_assert(PARAM_COUNT <= 32, "dirty bits are a uint32_t");
+
+/* Params ramped per sample instead of stepping once per block */
+enum SmoothedParam {
+    SMOOTH_TIMBRE = 0,
+    SMOOTH_COLOR,
+    SMOOTH_CUTOFF,
+    SMOOTH_VOLUME,
+    SMOOTH_COUNT
+};
+
+static const int g_smoothed_params[SMOOTH_COUNT] = {
+    PARAM_TIMBRE, PARAM_COLOR, PARAM_CUTOFF, PARAM_VOLUME
+};
+
+/* param_resync flags, set by the control thread when the queue is full */
+#define PARAM_RESYNC_PARAMS 1       /* Copy params[] whole */
+#define PARAM_RESYNC_VOICES 2       /* A voice reset was dropped */
+#define PARAM_RESYNC_SETTINGS 4     /* Apply settings[] whole */
+
+/*
+ * Render settings: set on the control thread in settings[], queued like
+ * params (PARAM_MSG_SETTING) and applied to the render thread's own fields
+ * by apply_setting
+ */
+enum {
+    SETTING_RENDER_MODE,            /* render_mode */
+    SETTING_FILTER_PERIOD,          /* filter_period */
+    SETTING_OSC_BLOCK,              /* osc_block */
+    SETTING_CLIP,                   /* clip */
+    SETTING_SILENCE_LEVEL,          /* silence_level; 0 = off */
+    SETTING_QUALITY_BUDGET,         /* quality_budget */
+    SETTING_OCTAVE_TRANSPOSE,       /* octave_transpose */
+    SETTING_MAX_VOICES,             /* vm.max_voices */
+    SETTING_VOICE_BUDGET,           /* vm.budget_pct */
+    SETTING_STATE_ARENA,            /* arena_packed */
+    SETTING_COUNT
+};
+
 struct BraidsPreset {
     char name[64];
     float params[PARAM_COUNT];
     int octave_transpose;
 };
 
+/*
+ * Compiled preset bank, <module_dir>/presets.bank, written by
+ * scripts/pack_presets.py from the .braids files: this header, the
+ * PARAM_COUNT param keys in BraidsParam order (NUL-terminated), then count
+ * BraidsPreset records, little-endian, used in place from the mapping. A
+ * bank whose version, record size or keys differ from the plugin's, or that
+ * is older than the presets directory, is ignored and the files are parsed.
+ */
+#define PRESET_BANK_FILE "presets.bank"
+#define PRESET_BANK_MAGIC 0x42505242u   /* "BRPB" */
+#define PRESET_BANK_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t param_count;
+    uint32_t record_size;       /* sizeof(BraidsPreset) */
+    uint32_t keys_offset;
+    uint32_t records_offset;    /* 8-byte aligned */
+    uint32_t reserved;
+} PresetBankHeader;
+
+static_assert(sizeof(BraidsPreset) == 64 + 4 * PARAM_COUNT + 4,
+              "BraidsPreset is the bank's record layout: no padding");
+
+/*
+ * Presets from <module_dir>/presets (the bank, else the .braids files),
+ * shared by every instance loaded from that directory. Loaded once, the
+ * first time an instance needs it, and freed with the last instance.
+ * Immutable once loaded.
+ */
+struct PresetLibrary {
+    char module_dir[256];
+    int refcount;
+    int loaded;
+    BraidsPreset *presets;      /* Into bank when mapped, else malloc'd */
+    int count;
+    void *bank;                 /* mmap of PRESET_BANK_FILE, or NULL */
+    size_t bank_size;
+    PresetLibrary *next;
+};
+
 static const param_def_t g_shadow_params[] = {
     {"engine",    "Engine",    PARAM_TYPE_INT,   PARAM_ENGINE,    0.0f, (float)(NUM_SHAPES - 1)},
     {"timbre",    "Timbre",    PARAM_TYPE_FLOAT, PARAM_TIMBRE,    0.0f, 1.0f},
@@ -201,24 +463,97 @@ static const param_def_t g_shadow_params[] = {
     {"f_sustain", "F.Sustain", PARAM_TYPE_FLOAT, PARAM_F_SUSTAIN, 0.0f, 1.0f},
     {"f_release", "F.Release", PARAM_TYPE_FLOAT, PARAM_F_RELEASE, 0.0f, 1.0f},
     {"volume",    "Volume",    PARAM_TYPE_FLOAT, PARAM_VOLUME,    0.0f, 1.0f},
+    {"unison",    "Unison",    PARAM_TYPE_INT,   PARAM_UNISON,    1.0f, (float)UNISON_MAX},
+    {"unison_spread", "Spread", PARAM_TYPE_FLOAT, PARAM_UNISON_SPREAD, 0.0f, 1.0f},
+    {"glide",     "Glide",     PARAM_TYPE_FLOAT, PARAM_GLIDE,     0.0f, 1.0f},
 };
 
 /* =====================================================================
  * Voice structure - one Braids oscillator per voice
  * ===================================================================== */
 
-struct BraidsVoice {
-    braids::MacroOscillator osc;
+/* Cache-line aligned, oscillator first: its hot state starts a line */
+struct alignas(CACHE_LINE_SIZE) BraidsVoice {
+    braids::MacroOscillator osc[2];  /* Per engine side; delay lines in the state arena */
     SimpleADSR amp_env;
     SimpleADSR filt_env;
     braids::Svf svf;
-    int16_t osc_buffer[BRAIDS_BLOCK_SIZE];
-    uint8_t sync_buffer[BRAIDS_BLOCK_SIZE];
+    unison_bank_t unison[2];
+    halfband_t halfband[2];  /* Decimator of each side's oscillator at high quality */
+    int side;       /* Side playing the voice's engine */
+    int fade_pos;   /* Samples into the crossfade from the other side */
+    uint32_t engine_gen;  /* Switch the voice's engine belongs to */
+    int16_t osc_buffer[BRAIDS_BLOCK_SIZE + 1];  /* Scalar path; + the spare of an even render */
+    int16_t fade_buffer[OSC_BLOCK_MAX];  /* The engine faded from */
+    int16_t osc_out[MOVE_FRAMES_PER_BLOCK + OSC_BLOCK_MAX];  /* Lanes path: block of osc output */
+    int16_t osc_fifo[OSC_BLOCK_MAX];  /* Rendered ahead of the host block */
+    float voice_mix[MOVE_FRAMES_PER_BLOCK];  /* Scalar path: gained output, mixed later */
+    float amp_level[MOVE_FRAMES_PER_BLOCK];  /* Lanes path: envelopes for the block */
+    float filt_level[MOVE_FRAMES_PER_BLOCK];
+    int idle_at;  /* Lanes path: sample amp_level went idle on */
+    int quiet;    /* Samples in a row the output peaked under silence_level */
+    int fifo_count;
+    uint32_t rng_state;  /* Noise stream, swapped in around each render job */
+    int32_t glide_from;        /* Pitch the glide to the note started at */
+    uint32_t glide_phase;      /* As a braids::Envelope segment's */
+    uint32_t glide_increment;  /* Per sample, lut_env_portamento_increments; 0 = none */
+#if BRAIDS_PERF_STATS
+    uint64_t job_ticks;  /* Cost of this voice's last render job */
+#endif
+    int16_t pitch;  /* Sounding pitch; render_engine_side hands it to the oscillators */
     int note;
     int velocity;
     int active;
     int gate;
     int age;  /* For voice stealing - higher = older */
+    int retiring;  /* Fading out because the voice ceiling dropped */
+};
+
+/* Per-engine voice cost model behind the dynamic voice ceiling */
+struct VoiceManager {
+    float cost[NUM_SHAPES];             /* EMA of ticks per voice per full block */
+    uint16_t samples[NUM_SHAPES];       /* Blocks that fed each estimate (saturating) */
+    int limit;                          /* Current voice ceiling; render thread writes */
+    int max_voices;                     /* User cap (max_voices) */
+    float budget_pct;                   /* voice_budget; 0 = fixed at max_voices */
+    float gain_voices;                  /* Smoothed ceiling used for gain normalisation */
+    int raise_holdoff;                  /* Blocks until the ceiling may rise again */
+};
+
+static uint64_t g_perf_ticks_per_sec = 1;
+
+#if BRAIDS_PERF_STATS
+/* Per-instance render cost, fed from v2_render_block */
+struct BraidsPerf {
+    perf_block_stats_t block;           /* Whole render_block calls */
+    uint64_t voice_last[MAX_VOICES];    /* Ticks spent on each voice last block */
+    uint64_t voice_ticks[MAX_VOICES];
+    uint64_t voice_blocks[MAX_VOICES];
+    uint64_t engine_ticks[NUM_SHAPES];  /* Per-voice cost attributed to engine */
+    uint64_t engine_blocks[NUM_SHAPES];
+    uint64_t post_last;                 /* Shared post-oscillator stage and mix */
+    uint64_t post_ticks;
+    uint64_t silence_retired;           /* Voices stopped by silence detection */
+    uint64_t quality_steps;             /* Automatic quality tier changes */
+};
+#endif
+
+/* Per-chunk render settings, fixed before any voice job starts */
+struct RenderFrame {
+    int16_t *out;                       /* Interleaved stereo, cleared by the caller */
+    int frames;
+    int mode;                           /* RenderMode */
+    int osc_block;                      /* Lanes path: oscillator block size */
+    float gain_scale;
+    int32_t pitch_offset;               /* FM and pitch bend, 1/128 semitones */
+    voice_lane_filter_t filter;         /* Scalar path reads enabled/cutoff/env_amount */
+    int32_t damp;
+    int clip;                           /* VOICE_LANES_CLIP_* */
+    int unison[2];                      /* Copies per voice on each side; 1 = off */
+    int unison_wave[2];                 /* UnisonWave for each side's engine */
+    int32_t unison_spread;              /* Outermost copy's detune, 1/128 semitones */
+    int quality;                        /* RenderQuality in use */
+    int oversample[2];                  /* Each side's engine renders at 2x */
 };
 
 /* =====================================================================
@@ -228,59 +563,368 @@ struct BraidsVoice {
 typedef struct {
     char module_dir[256];
     BraidsVoice voices[MAX_VOICES];
-    float params[PARAM_COUNT];
-    int octave_transpose;
+    float params[PARAM_COUNT];  /* Control thread: what get_param/state report */
+    float settings[SETTING_COUNT];  /* Control thread: render settings as set */
+    float silence_db;           /* Control thread: silence_threshold, dBFS */
+    int octave_transpose;       /* Render thread copy of the setting */
     int voice_counter;  /* For age tracking */
 
     /* Preset system */
-    BraidsPreset presets[MAX_PRESETS];
-    int preset_count;
+    PresetLibrary *preset_lib;  /* Shared; see preset_library_acquire */
     int current_preset;
     char preset_name[64];
 
-    /* Render state: accumulate Braids 24-sample blocks into Move 128-sample blocks */
-    int16_t render_buffer[MOVE_FRAMES_PER_BLOCK * 2]; /* stereo output */
+    /* get_param("state") cache, rebuilt when param_gen has moved on */
+    uint32_t param_gen;  /* Bumped on every preset/parameter change */
+    uint32_t state_gen;
+    int state_len;
+    char state_cache[1024];
+
+    /*
+     * Mod wheel, which arrives on the audio thread: on_midi publishes
+     * (count << 8) | CC value here, and the control thread folds it into
+     * params[] (take_midi_params) before it next reads or writes them
+     */
+    uint32_t midi_fm;           /* Written by the audio thread only */
+    uint32_t midi_fm_seen;      /* Control thread: the last one folded in */
+
+    /*
+     * Audio thread copy of params[]. set_param only writes params[] and
+     * queues the change; render_block drains the queue before rendering.
+     */
+    param_queue_t param_queue;
+    int param_resync;           /* PARAM_RESYNC_* */
+    float dsp_params[PARAM_COUNT];
+    float smooth_coef;
+    float smooth_state[SMOOTH_COUNT];
+    float smooth_ramp[SMOOTH_COUNT][MOVE_FRAMES_PER_BLOCK];
+    int smooth_snap;            /* Jump straight to the targets next block */
+
+    /* Derived from dsp_params, recomputed only when their inputs change */
+    uint32_t dsp_dirty;         /* PARAM_BIT()s changed since the last block */
+    SimpleADSR amp_rates;       /* Envelope rates for every voice (state unused) */
+    SimpleADSR filt_rates;
+    int32_t svf_damp;           /* lut_svf_damp for the current resonance */
+
+    /* Engine state arena, see carve_state_arena */
+    uint8_t *state_arena;       /* MAX_VOICES full-size slots per side, reserved once */
+    size_t arena_stride[2];     /* Bytes per voice as each side is carved */
+    int arena_carved;
+    int arena_packed;           /* state_arena: size slots for each side's engine */
+
+    /* Engine switching, see engine_switch_update */
+    int engine_shape;           /* Engine new notes play, on engine_side */
+    int engine_side;
+    int side_shape[2];          /* Engine each side was last set up for */
+    uint32_t engine_gen;        /* Bumped by every switch */
+    int engine_switching;       /* Voices are still fading or waiting to */
+
+    /*
+     * Render state: voices sum into a mono bus, saturated once on output.
+     * The settings here are the render thread's, written by apply_setting.
+     */
+    float mix_bus[MOVE_FRAMES_PER_BLOCK];  /* int16 units, before volume */
+    int clip;           /* Output saturation, VOICE_LANES_CLIP_* */
+    float silence_level;  /* silence_threshold in int16 units before volume; 0 = off */
+    int render_mode;    /* RenderMode */
+    int filter_period;  /* Lanes path: samples per filter envelope / cutoff update */
+    int osc_block;      /* Lanes path: oscillator block size (24, 32 or 64) */
+    VoiceManager vm;
+    int quality;                /* RenderQuality asked for; written by the control thread */
+    float quality_budget;       /* quality_budget, % of real time; 0 = never step */
+    int quality_active;         /* Tier rendered, at most quality */
+    int quality_asked;          /* quality as last seen by the render thread */
+    float quality_load;         /* EMA of render_block time, % of real time */
+    int quality_holdoff;        /* Blocks until the next step */
+    int quality_room;           /* Blocks in a row with room to step up */
+    int32_t pitch_bend;         /* 1/128 semitones, from the last bend message */
+    int32_t glide_origin;       /* Pitch of the last note on (glides start there) */
+    int glide_started;          /* glide_origin is set */
+
+    /* Voice jobs of the chunk being rendered, see render_voices */
+    RenderFrame frame;
+    int job_count;
+    uint8_t job_voices[MAX_VOICES];
+
+    /* Threaded rendering */
+    worker_pool_t *pool;        /* Acquired the first time threading is enabled */
+    int threading;              /* ThreadingMode; written by the control thread */
+    int pipeline_pending;       /* Frames of pipeline_out not handed out yet */
+    int pipeline_read;          /* The first of them */
+    int pipeline_inflight;      /* A batch is still rendering into pipeline_out */
+    int pipeline_unrecorded;    /* Its voice costs are not in perf yet */
+    uint32_t pipeline_ticket;
+    int16_t pipeline_out[MOVE_FRAMES_PER_BLOCK * 2];
+
+    /*
+     * MIDI waiting for render_block: timed events (midi_timing), and any
+     * message that arrived while a pipelined block was still rendering
+     */
+    int midi_timing;            /* MidiTiming; written by the control thread */
+    int midi_event_count;
+    MidiEvent midi_events[MIDI_EVENT_MAX];
+    uint64_t midi_block_time;   /* perf_now() at the last render_block */
+
+#if BRAIDS_PERF_STATS
+    /* DSP load instrumentation */
+    BraidsPerf perf;
+    float perf_budget_pct;          /* Overrun threshold, % of real time */
+    volatile int perf_reset_pending;
+#endif
 } braids_instance_t;
 
 /* =====================================================================
  * Utility functions
  * ===================================================================== */
 
+/*
+ * Logging is safe from any thread: lines are queued in g_log_ring and only
+ * reach g_host->log from log_flush, called where the plugin may block
+ * (init, create / destroy instance), or whoever polls get_param("log").
+ */
+static log_ring_t g_log_ring;
+
 static void plugin_log(const char *msg) {
-    if (g_host && g_host->log) {
-        char buf[256];
-        snprintf(buf, sizeof(buf), "[braids] %s", msg);
-        g_host->log(buf);
+    log_ring_printf(&g_log_ring, "[braids] %s", msg);
+}
+
+static void plugin_logf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void plugin_logf(const char *fmt, ...) {
+    char msg[LOG_RING_LINE];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, args);
+    va_end(args);
+    plugin_log(msg);
+}
+
+/* Control thread: hand the queued log lines to the host */
+static void log_flush(void) {
+    if (!g_host || !g_host->log || !log_ring_begin_drain(&g_log_ring)) return;
+    char line[LOG_RING_LINE];
+    while (log_ring_pop(&g_log_ring, line, sizeof(line))) g_host->log(line);
+    uint32_t dropped = log_ring_take_dropped(&g_log_ring);
+    if (dropped) {
+        snprintf(line, sizeof(line), "[braids] %u log lines dropped (ring full)", dropped);
+        g_host->log(line);
     }
+    log_ring_end_drain(&g_log_ring);
 }
 
+/* get_param("log"): the queued lines, one per '\n', as many as fit in buf */
+static int log_poll(char *buf, int buf_len) {
+    if (buf_len < 1) return -1;
+    int len = 0;
+    buf[0] = '\0';
+    if (!log_ring_begin_drain(&g_log_ring)) return 0;
+    const char *line;
+    while ((line = log_ring_peek(&g_log_ring)) != NULL) {
+        int n = (int)strlen(line);
+        if (len + n + 2 > buf_len) break;  /* Left for the next poll */
+        memcpy(buf + len, line, n);
+        len += n;
+        buf[len++] = '\n';
+        buf[len] = '\0';
+        log_ring_next(&g_log_ring);
+    }
+    log_ring_end_drain(&g_log_ring);
+    return len;
+}
+
+#if BRAIDS_RT_WATCHDOG
+static void rt_watch_report(int kind, const void *caller) {
+    log_ring_printf(&g_log_ring, "[braids] rt watchdog: %s call on the audio path from %p",
+                    g_rt_watch_names[kind], caller);
+}
+#endif
+
 /* Convert MIDI note to Braids pitch (128ths of semitone, C3 = 60*128 = 7680) */
 static int16_t note_to_pitch(int note) {
-    int16_t pitch = (int16_t)(note * 128);
-    /* Apply pitch correction for 44.1kHz (tables calibrated for 96kHz) */
-    pitch += PITCH_CORRECTION;
-    return pitch;
+    return (int16_t)(note * 128);
+}
+
+/* Worst-case samples rendered ahead of the host block for an oscillator block size */
+static int osc_fifo_latency(int osc_block) {
+    int a = osc_block, b = MOVE_FRAMES_PER_BLOCK;
+    while (b) { int t = a % b; a = b; b = t; }
+    return osc_block - a;
+}
+
+/* A dBFS level in int16 units */
+static float dbfs_to_level(float db) {
+    return 32768.0f * powf(10.0f, db / 20.0f);
 }
 
 /* =====================================================================
  * Voice management
  * ===================================================================== */
 
-static int find_free_voice(braids_instance_t *inst) {
-    /* First: find inactive voice */
+static int clamp_shape(float engine) {
+    int shape = (int)engine;
+    if (shape < 0) shape = 0;
+    if (shape >= NUM_SHAPES) shape = NUM_SHAPES - 1;
+    return shape;
+}
+
+/* Engine the audio thread is switching to or playing */
+static int current_shape(const braids_instance_t *inst) {
+    return inst->engine_shape;
+}
+
+/* Voices counted against the ceiling (retiring voices are already on their way out) */
+static int count_sounding_voices(const braids_instance_t *inst) {
+    int count = 0;
     for (int i = 0; i < MAX_VOICES; i++) {
-        if (!inst->voices[i].active) return i;
+        if (inst->voices[i].active && !inst->voices[i].retiring) count++;
+    }
+    return count;
+}
+
+/*
+ * Pick the voice that is cheapest to lose: a retiring voice, then the
+ * quietest released voice, then the oldest held voice.
+ * Returns -1 if nothing is active.
+ */
+static int find_voice_to_steal(braids_instance_t *inst, int include_retiring) {
+    int best = -1;
+    int best_rank = 0;
+    float best_level = 0.0f;
+    int best_age = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        BraidsVoice *v = &inst->voices[i];
+        if (!v->active) continue;
+        if (v->retiring && !include_retiring) continue;
+        int rank = v->retiring ? 0 : (!v->gate ? 1 : 2);
+        if (best < 0 || rank < best_rank
+            || (rank == best_rank && rank == 1 && v->amp_env.level < best_level)
+            || (rank == best_rank && rank != 1 && v->age < best_age)) {
+            best = i;
+            best_rank = rank;
+            best_level = v->amp_env.level;
+            best_age = v->age;
+        }
+    }
+    return best;
+}
+
+static int find_free_voice(braids_instance_t *inst) {
+    /* First: a free slot, as long as the voice ceiling allows another voice */
+    if (count_sounding_voices(inst) < inst->vm.limit) {
+        for (int i = 0; i < MAX_VOICES; i++) {
+            if (!inst->voices[i].active) return i;
+        }
+    }
+    /* Second: steal */
+    int vi = find_voice_to_steal(inst, 1);
+    return vi >= 0 ? vi : 0;
+}
+
+/* Fade out voices above the ceiling after it has been lowered */
+static void enforce_voice_limit(braids_instance_t *inst) {
+    int excess = count_sounding_voices(inst) - inst->vm.limit;
+    while (excess-- > 0) {
+        int vi = find_voice_to_steal(inst, 0);
+        if (vi < 0) break;
+        BraidsVoice *v = &inst->voices[vi];
+        v->retiring = 1;
+        v->gate = 0;
+        v->amp_env.release_rate = VOICE_RETIRE_RATE;
+        v->amp_env.gate_off();
+        v->filt_env.gate_off();
+    }
+}
+
+/*
+ * Feed one block's render time into the current engine's cost estimate and
+ * move the voice ceiling towards what fits in the budget. The ceiling drops
+ * at once and rises at most every VOICE_LIMIT_RAISE_BLOCKS.
+ */
+static void voice_manager_update(braids_instance_t *inst, uint64_t ticks, int voices,
+                                 int frames) {
+    VoiceManager *vm = &inst->vm;
+    int shape = current_shape(inst);
+
+    /* Fading voices render two engines: no estimate for either */
+    if (voices > 0 && frames > 0 && !inst->engine_switching) {
+        float per_voice = (float)ticks * MOVE_FRAMES_PER_BLOCK / (float)frames / (float)voices;
+        if (vm->samples[shape] == 0) {
+            vm->cost[shape] = per_voice;
+        } else {
+            vm->cost[shape] += (per_voice - vm->cost[shape]) * (1.0f / 16.0f);
+        }
+        if (vm->samples[shape] < 0xFFFF) vm->samples[shape]++;
+    }
+    if (vm->raise_holdoff > 0) vm->raise_holdoff--;
+
+    int target;
+    if (vm->budget_pct <= 0.0f) {
+        target = vm->max_voices;
+    } else if (vm->samples[shape] < VOICE_COST_MIN_SAMPLES || vm->cost[shape] <= 0.0f) {
+        target = DEFAULT_VOICES;
+    } else {
+        float budget = (float)g_perf_ticks_per_sec * MOVE_FRAMES_PER_BLOCK / MOVE_SAMPLE_RATE
+                       * vm->budget_pct / 100.0f;
+        target = (int)(budget / vm->cost[shape]);
+    }
+    if (target > vm->max_voices) target = vm->max_voices;
+    if (target < 1) target = 1;
+
+    if (target < vm->limit || (target > vm->limit && vm->raise_holdoff == 0)) {
+        __atomic_store_n(&vm->limit, target, __ATOMIC_RELAXED);
+        vm->raise_holdoff = VOICE_LIMIT_RAISE_BLOCKS;
+    }
+
+    /* Normalise by the voices actually sounding, never below the original 4 */
+    float norm = (float)(voices > DEFAULT_VOICES ? voices : DEFAULT_VOICES);
+    vm->gain_voices += (norm - vm->gain_voices) * 0.2f;
+}
+
+/*
+ * Move the quality tier in use with the render load, an EMA of render_block
+ * time: a tier down while it is over quality_budget, a tier back up (to at
+ * most quality) once it has stayed under QUALITY_RAISE_HEADROOM of the
+ * budget for QUALITY_RAISE_BLOCKS. A new quality applies at once.
+ */
+static void quality_update(braids_instance_t *inst, uint64_t ticks, int frames) {
+    int asked = __atomic_load_n(&inst->quality, __ATOMIC_RELAXED);
+    int active = inst->quality_active;
+    if (asked != inst->quality_asked) {
+        inst->quality_asked = asked;
+        active = asked;
+        inst->quality_holdoff = QUALITY_STEP_BLOCKS;
+        inst->quality_room = 0;
     }
-    /* Second: steal oldest voice */
-    int oldest = 0;
-    int oldest_age = inst->voices[0].age;
-    for (int i = 1; i < MAX_VOICES; i++) {
-        if (inst->voices[i].age < oldest_age) {
-            oldest_age = inst->voices[i].age;
-            oldest = i;
+    if (frames > 0) {
+        float realtime = (float)g_perf_ticks_per_sec * frames / MOVE_SAMPLE_RATE;
+        float load = (float)ticks * 100.0f / realtime;
+        inst->quality_load += (load - inst->quality_load) * (1.0f / 16.0f);
+    }
+    if (inst->quality_holdoff > 0) inst->quality_holdoff--;
+
+    float budget = inst->quality_budget;
+    int step = 0;
+    if (budget <= 0.0f) {
+        active = asked;
+    } else if (inst->quality_holdoff == 0) {
+        if (inst->quality_load > budget && active > QUALITY_ECO) {
+            step = -1;
+        } else if (active < asked && inst->quality_load < budget * QUALITY_RAISE_HEADROOM) {
+            if (++inst->quality_room >= QUALITY_RAISE_BLOCKS) step = 1;
+        } else {
+            inst->quality_room = 0;
         }
     }
-    return oldest;
+    if (step) {
+        active += step;
+        inst->quality_holdoff = QUALITY_STEP_BLOCKS;
+        inst->quality_room = 0;
+        plugin_logf("render load %.1f%% (budget %.1f%%): quality %s",
+                    inst->quality_load, budget, g_quality_names[active]);
+#if BRAIDS_PERF_STATS
+        inst->perf.quality_steps++;
+#endif
+    }
+    __atomic_store_n(&inst->quality_active, active, __ATOMIC_RELAXED);
 }
 
 static int find_voice_for_note(braids_instance_t *inst, int note) {
@@ -299,53 +943,103 @@ static int find_voice_for_note(braids_instance_t *inst, int note) {
  * Plugin API v2
  * ===================================================================== */
 
-/* Helper to extract a JSON number value by key */
-static int json_get_number(const char *json, const char *key, float *out) {
-    char search[64];
-    snprintf(search, sizeof(search), "\"%s\":", key);
-    const char *pos = strstr(json, search);
-    if (!pos) return -1;
-    pos += strlen(search);
-    while (*pos == ' ') pos++;
-    *out = (float)atof(pos);
-    return 0;
+/* Control thread: mark serialised parameter state stale */
+static inline void params_changed(braids_instance_t *inst) {
+    inst->param_gen++;
 }
 
-/* Helper to extract a JSON string value by key */
-static int json_get_string(const char *json, const char *key, char *out, int out_len) {
-    char search[64];
-    snprintf(search, sizeof(search), "\"%s\":", key);
-    const char *pos = strstr(json, search);
-    if (!pos) return -1;
-    pos += strlen(search);
-    while (*pos == ' ') pos++;
-    if (*pos != '"') return -1;
-    pos++; /* skip opening quote */
-    int i = 0;
-    while (*pos && *pos != '"' && i < out_len - 1) {
-        out[i++] = *pos++;
+/* Control thread: take in a mod wheel move the audio thread has published */
+static void take_midi_params(braids_instance_t *inst) {
+    uint32_t fm = __atomic_load_n(&inst->midi_fm, __ATOMIC_ACQUIRE);
+    if (fm == inst->midi_fm_seen) return;
+    inst->midi_fm_seen = fm;
+    inst->params[PARAM_FM] = (fm & 0x7f) / 127.0f;
+    params_changed(inst);
+}
+
+/* Control thread: queue params[index] for the audio thread */
+static void publish_param(braids_instance_t *inst, int index) {
+    param_msg_t m = { PARAM_MSG_SET, (int16_t)index, inst->params[index] };
+    if (param_queue_push(&inst->param_queue, &m) != 0) {
+        __atomic_fetch_or(&inst->param_resync, PARAM_RESYNC_PARAMS, __ATOMIC_RELEASE);
+    }
+}
+
+static void publish_all_params(braids_instance_t *inst) {
+    for (int i = 0; i < PARAM_COUNT; i++) publish_param(inst, i);
+}
+
+/* Control thread: have the audio thread silence all voices */
+static void publish_voice_reset(braids_instance_t *inst) {
+    param_msg_t m = { PARAM_MSG_RESET_VOICES, 0, 0.0f };
+    if (param_queue_push(&inst->param_queue, &m) != 0) {
+        __atomic_fetch_or(&inst->param_resync, PARAM_RESYNC_VOICES, __ATOMIC_RELEASE);
+    }
+}
+
+/* Control thread: queue settings[id] for the audio thread */
+static void publish_setting(braids_instance_t *inst, int id) {
+    param_msg_t m = { PARAM_MSG_SETTING, (int16_t)id, inst->settings[id] };
+    if (param_queue_push(&inst->param_queue, &m) != 0) {
+        __atomic_fetch_or(&inst->param_resync, PARAM_RESYNC_SETTINGS, __ATOMIC_RELEASE);
+    }
+}
+
+static void set_setting(braids_instance_t *inst, int id, float value) {
+    inst->settings[id] = value;
+    publish_setting(inst, id);
+}
+
+/* Render thread: take in one render setting; the only writer of vm.limit */
+static void apply_setting(braids_instance_t *inst, int id, float value) {
+    VoiceManager *vm = &inst->vm;
+    switch (id) {
+        case SETTING_RENDER_MODE:      inst->render_mode = (int)value; break;
+        case SETTING_FILTER_PERIOD:    inst->filter_period = (int)value; break;
+        case SETTING_OSC_BLOCK:        inst->osc_block = (int)value; break;
+        case SETTING_CLIP:             inst->clip = (int)value; break;
+        case SETTING_SILENCE_LEVEL:    inst->silence_level = value; break;
+        case SETTING_QUALITY_BUDGET:   inst->quality_budget = value; break;
+        case SETTING_OCTAVE_TRANSPOSE: inst->octave_transpose = (int)value; break;
+        case SETTING_STATE_ARENA:      inst->arena_packed = (int)value; break;
+        case SETTING_MAX_VOICES:
+            vm->max_voices = (int)value;
+            if (vm->limit > vm->max_voices) {
+                __atomic_store_n(&vm->limit, vm->max_voices, __ATOMIC_RELAXED);
+            }
+            break;
+        case SETTING_VOICE_BUDGET:
+            vm->budget_pct = value;
+            if (value <= 0.0f) __atomic_store_n(&vm->limit, vm->max_voices, __ATOMIC_RELAXED);
+            break;
+        default:
+            break;
     }
-    out[i] = '\0';
-    return i;
+}
+
+static int preset_count(const braids_instance_t *inst) {
+    return inst->preset_lib ? inst->preset_lib->count : 0;
 }
 
 /* Apply preset to instance parameters */
 static void v2_apply_preset(braids_instance_t *inst, int preset_idx) {
-    if (preset_idx < 0 || preset_idx >= inst->preset_count) return;
+    if (preset_idx < 0 || preset_idx >= preset_count(inst)) return;
 
-    BraidsPreset *p = &inst->presets[preset_idx];
+    const BraidsPreset *p = &inst->preset_lib->presets[preset_idx];
     snprintf(inst->preset_name, sizeof(inst->preset_name), "%s", p->name);
 
     for (int i = 0; i < PARAM_COUNT; i++) {
         inst->params[i] = p->params[i];
     }
-    inst->octave_transpose = p->octave_transpose;
+    params_changed(inst);
+    publish_all_params(inst);
+    set_setting(inst, SETTING_OCTAVE_TRANSPOSE, (float)p->octave_transpose);
 }
 
-/* Load a single .braids preset file */
-static int load_braids_preset(braids_instance_t *inst, const char *path) {
-    if (inst->preset_count >= MAX_PRESETS) return -1;
+static void parse_preset_json(BraidsPreset *p, int index, const char *json);
 
+/* Parse a single .braids preset file into *p (index used for the fallback name) */
+static int load_braids_preset(BraidsPreset *p, int index, const char *path) {
     FILE *f = fopen(path, "r");
     if (!f) return -1;
 
@@ -361,75 +1055,8 @@ static int load_braids_preset(braids_instance_t *inst, const char *path) {
     data[size] = '\0';
     fclose(f);
 
-    BraidsPreset *p = &inst->presets[inst->preset_count];
-    memset(p, 0, sizeof(BraidsPreset));
-
-    /* Parse name */
-    if (json_get_string(data, "name", p->name, sizeof(p->name)) < 0) {
-        snprintf(p->name, sizeof(p->name), "Preset %d", inst->preset_count);
-    }
-
-    /* Parse engine (string name or number) */
-    char engine_str[32];
-    if (json_get_string(data, "engine", engine_str, sizeof(engine_str)) >= 0) {
-        p->params[PARAM_ENGINE] = 0;
-        for (int i = 0; i < NUM_SHAPES; i++) {
-            if (strcmp(engine_str, g_shape_names[i]) == 0) {
-                p->params[PARAM_ENGINE] = (float)i;
-                break;
-            }
-        }
-    } else {
-        float fval;
-        if (json_get_number(data, "engine", &fval) == 0) {
-            p->params[PARAM_ENGINE] = fval;
-        }
-    }
-
-    /* Parse float params */
-    float fval;
-    if (json_get_number(data, "timbre", &fval) == 0) p->params[PARAM_TIMBRE] = fval;
-    else p->params[PARAM_TIMBRE] = 0.5f;
-    if (json_get_number(data, "color", &fval) == 0) p->params[PARAM_COLOR] = fval;
-    else p->params[PARAM_COLOR] = 0.5f;
-    if (json_get_number(data, "attack", &fval) == 0) p->params[PARAM_ATTACK] = fval;
-    else p->params[PARAM_ATTACK] = 0.0f;
-    if (json_get_number(data, "decay", &fval) == 0) p->params[PARAM_DECAY] = fval;
-    else p->params[PARAM_DECAY] = 0.5f;
-    if (json_get_number(data, "sustain", &fval) == 0) p->params[PARAM_SUSTAIN] = fval;
-    else p->params[PARAM_SUSTAIN] = 1.0f;
-    if (json_get_number(data, "release", &fval) == 0) p->params[PARAM_RELEASE] = fval;
-    else p->params[PARAM_RELEASE] = 0.3f;
-    if (json_get_number(data, "fm", &fval) == 0) p->params[PARAM_FM] = fval;
-    else p->params[PARAM_FM] = 0.0f;
-    if (json_get_number(data, "cutoff", &fval) == 0) p->params[PARAM_CUTOFF] = fval;
-    else p->params[PARAM_CUTOFF] = 1.0f;
-    if (json_get_number(data, "resonance", &fval) == 0) p->params[PARAM_RESONANCE] = fval;
-    else p->params[PARAM_RESONANCE] = 0.0f;
-    if (json_get_number(data, "filt_env", &fval) == 0) p->params[PARAM_FILT_ENV] = fval;
-    else p->params[PARAM_FILT_ENV] = 0.0f;
-    if (json_get_number(data, "f_attack", &fval) == 0) p->params[PARAM_F_ATTACK] = fval;
-    else p->params[PARAM_F_ATTACK] = 0.0f;
-    if (json_get_number(data, "f_decay", &fval) == 0) p->params[PARAM_F_DECAY] = fval;
-    else p->params[PARAM_F_DECAY] = 0.3f;
-    if (json_get_number(data, "f_sustain", &fval) == 0) p->params[PARAM_F_SUSTAIN] = fval;
-    else p->params[PARAM_F_SUSTAIN] = 0.0f;
-    if (json_get_number(data, "f_release", &fval) == 0) p->params[PARAM_F_RELEASE] = fval;
-    else p->params[PARAM_F_RELEASE] = 0.3f;
-    if (json_get_number(data, "volume", &fval) == 0) p->params[PARAM_VOLUME] = fval;
-    else p->params[PARAM_VOLUME] = 0.7f;
-
-    /* Parse octave transpose */
-    if (json_get_number(data, "octave_transpose", &fval) == 0) {
-        p->octave_transpose = (int)fval;
-        if (p->octave_transpose < -3) p->octave_transpose = -3;
-        if (p->octave_transpose > 3) p->octave_transpose = 3;
-    } else {
-        p->octave_transpose = 0;
-    }
-
+    parse_preset_json(p, index, data);
     free(data);
-    inst->preset_count++;
     return 0;
 }
 
@@ -438,10 +1065,98 @@ static int preset_name_cmp(const void *a, const void *b) {
     return strcmp(*(const char**)a, *(const char**)b);
 }
 
-/* Load all .braids presets from presets/ directory */
-static void load_presets(braids_instance_t *inst) {
+/* Key of BraidsParam index, from the shadow param table */
+static const char *param_key(int index) {
+    for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params); i++) {
+        if (g_shadow_params[i].index == index) return g_shadow_params[i].key;
+    }
+    return "";
+}
+
+/* Whether a mapped bank is one this build can use in place */
+static int preset_bank_valid(const uint8_t *map, size_t size) {
+    if (size < sizeof(PresetBankHeader)) return 0;
+    const PresetBankHeader *h = (const PresetBankHeader*)map;
+    if (h->magic != PRESET_BANK_MAGIC || h->version != PRESET_BANK_VERSION) return 0;
+    if (h->param_count != PARAM_COUNT || h->record_size != sizeof(BraidsPreset)) return 0;
+    if (h->records_offset % 8 != 0 || h->records_offset > size
+        || h->count > (size - h->records_offset) / sizeof(BraidsPreset)) return 0;
+
+    const char *key = (const char*)map + h->keys_offset;
+    const char *end = (const char*)map + h->records_offset;
+    if (h->keys_offset > h->records_offset) return 0;
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        const char *nul = (const char*)memchr(key, '\0', end - key);
+        if (!nul || strcmp(key, param_key(i)) != 0) return 0;
+        key = nul + 1;
+    }
+    return 1;
+}
+
+/* Whether presets/ or any .braids file in it changed after mtime */
+static int presets_newer_than(const char *presets_dir, time_t mtime) {
+    struct stat st;
+    if (stat(presets_dir, &st) == 0 && st.st_mtime > mtime) return 1;
+    DIR *dir = opendir(presets_dir);
+    if (!dir) return 0;
+    int newer = 0;
+    struct dirent *ent;
+    while (!newer && (ent = readdir(dir)) != NULL) {
+        const char *name = ent->d_name;
+        int len = strlen(name);
+        if (len <= 7 || strcmp(name + len - 7, ".braids") != 0) continue;
+        char path[768];
+        snprintf(path, sizeof(path), "%s/%s", presets_dir, name);
+        newer = stat(path, &st) == 0 && st.st_mtime > mtime;
+    }
+    closedir(dir);
+    return newer;
+}
+
+/* Map <module_dir>/presets.bank into the library. Returns: 0, -1 if unusable */
+static int map_preset_bank(PresetLibrary *lib, const char *presets_dir) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", lib->module_dir, PRESET_BANK_FILE);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat bank_st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &bank_st) == 0 && bank_st.st_size > 0) {
+        /* Presets added, removed or edited since the bank was built: parse them */
+        if (presets_newer_than(presets_dir, bank_st.st_mtime)) {
+            plugin_log("Preset bank is older than the preset files, parsing them");
+        } else {
+            map = mmap(NULL, bank_st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+    }
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    if (!preset_bank_valid((const uint8_t*)map, bank_st.st_size)) {
+        plugin_log("Preset bank does not match this build, parsing files");
+        munmap(map, bank_st.st_size);
+        return -1;
+    }
+    const PresetBankHeader *h = (const PresetBankHeader*)map;
+    lib->bank = map;
+    lib->bank_size = bank_st.st_size;
+    lib->presets = (BraidsPreset*)((uint8_t*)map + h->records_offset);
+    lib->count = h->count;
+    return 0;
+}
+
+/* Load the presets into the library: the compiled bank if usable, else presets/ */
+static void load_presets(PresetLibrary *lib) {
     char presets_dir[512];
-    snprintf(presets_dir, sizeof(presets_dir), "%s/presets", inst->module_dir);
+    snprintf(presets_dir, sizeof(presets_dir), "%s/presets", lib->module_dir);
+
+    if (map_preset_bank(lib, presets_dir) == 0) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "Mapped %d presets from %s", lib->count, PRESET_BANK_FILE);
+        plugin_log(msg);
+        return;
+    }
 
     DIR *dir = opendir(presets_dir);
     if (!dir) {
@@ -452,135 +1167,382 @@ static void load_presets(braids_instance_t *inst) {
     }
 
     /* Collect .braids filenames for sorted loading */
-    char *filenames[MAX_PRESETS];
+    char **filenames = NULL;
     int file_count = 0;
+    int file_capacity = 0;
 
     struct dirent *ent;
-    while ((ent = readdir(dir)) != NULL && file_count < MAX_PRESETS) {
+    while ((ent = readdir(dir)) != NULL) {
         const char *name = ent->d_name;
         int len = strlen(name);
-        if (len > 7 && strcmp(name + len - 7, ".braids") == 0) {
-            filenames[file_count] = strdup(name);
-            if (filenames[file_count]) file_count++;
+        if (len <= 7 || strcmp(name + len - 7, ".braids") != 0) continue;
+        if (file_count == file_capacity) {
+            int capacity = file_capacity ? file_capacity * 2 : PRESET_LIBRARY_INITIAL_CAPACITY;
+            char **grown = (char**)realloc(filenames, capacity * sizeof(char*));
+            if (!grown) break;
+            filenames = grown;
+            file_capacity = capacity;
         }
+        filenames[file_count] = strdup(name);
+        if (filenames[file_count]) file_count++;
     }
     closedir(dir);
 
     /* Sort alphabetically so numbering prefix controls order */
-    qsort(filenames, file_count, sizeof(char*), preset_name_cmp);
+    if (file_count > 0) {
+        qsort(filenames, file_count, sizeof(char*), preset_name_cmp);
+        lib->presets = (BraidsPreset*)malloc(file_count * sizeof(BraidsPreset));
+    }
 
     /* Load each preset */
     for (int i = 0; i < file_count; i++) {
         char path[768];
         snprintf(path, sizeof(path), "%s/%s", presets_dir, filenames[i]);
-        load_braids_preset(inst, path);
+        if (lib->presets && load_braids_preset(&lib->presets[lib->count], lib->count, path) == 0) {
+            lib->count++;
+        }
         free(filenames[i]);
     }
+    free(filenames);
 
     char msg[128];
-    snprintf(msg, sizeof(msg), "Loaded %d presets", inst->preset_count);
+    snprintf(msg, sizeof(msg), "Loaded %d presets", lib->count);
     plugin_log(msg);
 }
 
-static void apply_params_to_voice(braids_instance_t *inst, BraidsVoice *v) {
-    int shape = (int)inst->params[PARAM_ENGINE];
-    if (shape < 0) shape = 0;
-    if (shape >= NUM_SHAPES) shape = NUM_SHAPES - 1;
-    v->osc.set_shape((braids::MacroOscillatorShape)shape);
+/* Shared preset libraries, one per module directory */
+static PresetLibrary *g_preset_libs = NULL;
+static pthread_mutex_t g_preset_libs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Take a reference on the library for module_dir (created empty if needed) */
+static PresetLibrary *preset_library_acquire(const char *module_dir) {
+    pthread_mutex_lock(&g_preset_libs_lock);
+    PresetLibrary *lib = g_preset_libs;
+    while (lib && strcmp(lib->module_dir, module_dir) != 0) lib = lib->next;
+    if (!lib) {
+        lib = (PresetLibrary*)calloc(1, sizeof(PresetLibrary));
+        if (lib) {
+            snprintf(lib->module_dir, sizeof(lib->module_dir), "%s", module_dir);
+            lib->next = g_preset_libs;
+            g_preset_libs = lib;
+        }
+    }
+    if (lib) lib->refcount++;
+    pthread_mutex_unlock(&g_preset_libs_lock);
+    return lib;
+}
 
-    int16_t timbre = (int16_t)(inst->params[PARAM_TIMBRE] * 32767.0f);
-    int16_t color = (int16_t)(inst->params[PARAM_COLOR] * 32767.0f);
-    v->osc.set_parameters(timbre, color);
+/* Parse the presets on first use; later calls return the cached count */
+static int preset_library_load(PresetLibrary *lib) {
+    if (!lib) return 0;
+    pthread_mutex_lock(&g_preset_libs_lock);
+    if (!lib->loaded) {
+        load_presets(lib);
+        lib->loaded = 1;
+    }
+    int count = lib->count;
+    pthread_mutex_unlock(&g_preset_libs_lock);
+    return count;
+}
 
-    /* SVF filter resonance (cutoff set per-sample in render for envelope modulation) */
-    int16_t reso_val = (int16_t)(inst->params[PARAM_RESONANCE] * 32767.0f);
-    v->svf.set_resonance(reso_val);
-
-    /* ADSR envelopes */
-    v->amp_env.set_params(
-        inst->params[PARAM_ATTACK],
-        inst->params[PARAM_DECAY],
-        inst->params[PARAM_SUSTAIN],
-        inst->params[PARAM_RELEASE]);
-    v->filt_env.set_params(
-        inst->params[PARAM_F_ATTACK],
-        inst->params[PARAM_F_DECAY],
-        inst->params[PARAM_F_SUSTAIN],
-        inst->params[PARAM_F_RELEASE]);
+/* Drop a reference; the last one frees the library */
+static void preset_library_release(PresetLibrary *lib) {
+    if (!lib) return;
+    pthread_mutex_lock(&g_preset_libs_lock);
+    if (--lib->refcount == 0) {
+        PresetLibrary **link = &g_preset_libs;
+        while (*link != lib) link = &(*link)->next;
+        *link = lib->next;
+        if (lib->bank) munmap(lib->bank, lib->bank_size);
+        else free(lib->presets);
+        free(lib);
+    }
+    pthread_mutex_unlock(&g_preset_libs_lock);
 }
 
-/* v2 API: Create instance */
-static void* v2_create_instance(const char *module_dir, const char *json_defaults) {
-    (void)json_defaults;
+/*
+ * Audio thread: push the params whose bits are set in dirty to a voice.
+ * Timbre / color are set along their ramps during render, and cutoff,
+ * volume and FM are read per block, so only these need pushing.
+ */
+static void update_voice_params(braids_instance_t *inst, BraidsVoice *v, uint32_t dirty) {
+    /* The engine moves through engine_switch_update */
 
-    braids_instance_t *inst = (braids_instance_t*)calloc(1, sizeof(braids_instance_t));
-    if (!inst) return NULL;
+    /* SVF filter resonance (cutoff set per-sample in render for envelope modulation) */
+    if (dirty & PARAM_BIT(PARAM_RESONANCE)) {
+        v->svf.set_resonance((int16_t)(inst->dsp_params[PARAM_RESONANCE] * 32767.0f));
+    }
 
-    strncpy(inst->module_dir, module_dir, sizeof(inst->module_dir) - 1);
+    /* ADSR envelopes: rates are computed once per change, in amp/filt_rates */
+    if (dirty & AMP_ENV_BITS) {
+        v->amp_env.copy_rates(inst->amp_rates);
+        if (v->retiring) v->amp_env.release_rate = VOICE_RETIRE_RATE;
+    }
+    if (dirty & FILT_ENV_BITS) {
+        v->filt_env.copy_rates(inst->filt_rates);
+    }
+}
 
-    /* Default parameters */
-    inst->params[PARAM_ENGINE] = 0.0f;
-    inst->params[PARAM_TIMBRE] = 0.5f;
-    inst->params[PARAM_COLOR] = 0.5f;
-    inst->params[PARAM_ATTACK] = 0.0f;
-    inst->params[PARAM_DECAY] = 0.5f;
-    inst->params[PARAM_SUSTAIN] = 1.0f;
-    inst->params[PARAM_RELEASE] = 0.3f;
-    inst->params[PARAM_FM] = 0.0f;
-    inst->params[PARAM_CUTOFF] = 1.0f;
-    inst->params[PARAM_RESONANCE] = 0.0f;
-    inst->params[PARAM_FILT_ENV] = 0.0f;
-    inst->params[PARAM_F_ATTACK] = 0.0f;
-    inst->params[PARAM_F_DECAY] = 0.3f;
-    inst->params[PARAM_F_SUSTAIN] = 0.0f;
-    inst->params[PARAM_F_RELEASE] = 0.3f;
-    inst->params[PARAM_VOLUME] = 0.7f;
-    inst->octave_transpose = 0;
-    inst->voice_counter = 0;
-    inst->preset_count = 0;
-    inst->current_preset = 0;
-    snprintf(inst->preset_name, sizeof(inst->preset_name), "Init");
+/* Audio thread: set a newly struck voice up from the current params */
+static void apply_params_to_voice(braids_instance_t *inst, BraidsVoice *v) {
+    update_voice_params(inst, v, ALL_PARAM_BITS);
+    int16_t timbre = (int16_t)(inst->smooth_state[SMOOTH_TIMBRE] * 32767.0f);
+    int16_t color = (int16_t)(inst->smooth_state[SMOOTH_COLOR] * 32767.0f);
+    v->osc[v->side].set_parameters(timbre, color);
+}
 
-    /* Init all voices */
-    for (int i = 0; i < MAX_VOICES; i++) {
-        inst->voices[i].osc.Init();
-        inst->voices[i].amp_env.init();
-        inst->voices[i].filt_env.init();
-        inst->voices[i].svf.Init();
-        inst->voices[i].active = 0;
-        inst->voices[i].gate = 0;
-        inst->voices[i].note = 0;
-        inst->voices[i].velocity = 0;
-        inst->voices[i].age = 0;
-        memset(inst->voices[i].osc_buffer, 0, sizeof(inst->voices[i].osc_buffer));
-        memset(inst->voices[i].sync_buffer, 0, sizeof(inst->voices[i].sync_buffer));
+/*
+ * Audio thread: with glide up, a new note slides from the pitch of the last
+ * note on (any voice) over up to 0.25 s, like Braids' portamento
+ */
+static void voice_start_glide(braids_instance_t *inst, BraidsVoice *v) {
+    int32_t pitch = note_to_pitch(v->note);
+    int index = (int)(inst->dsp_params[PARAM_GLIDE] * 127.0f + 0.5f);
+    if (index > 127) index = 127;
+    v->glide_increment = 0;
+    if (index > 0 && inst->glide_started && inst->glide_origin != pitch) {
+        v->glide_from = inst->glide_origin;
+        v->glide_phase = 0;
+        v->glide_increment = braids::lut_env_portamento_increments[index];
     }
+    inst->glide_origin = pitch;
+    inst->glide_started = 1;
+}
 
-    /* Load presets from disk */
-    load_presets(inst);
-    if (inst->preset_count > 0) {
-        inst->current_preset = 0;
-        v2_apply_preset(inst, 0);
+/*
+ * Audio thread: refresh what is derived from the params that changed since
+ * the last call. Returns: the dirty bits, for update_voice_params
+ */
+static uint32_t update_param_caches(braids_instance_t *inst) {
+    uint32_t dirty = inst->dsp_dirty;
+    const float *params = inst->dsp_params;
+    inst->dsp_dirty = 0;
+
+    if (dirty & AMP_ENV_BITS) {
+        inst->amp_rates.set_params(params[PARAM_ATTACK], params[PARAM_DECAY],
+                                   params[PARAM_SUSTAIN], params[PARAM_RELEASE]);
+    }
+    if (dirty & FILT_ENV_BITS) {
+        inst->filt_rates.set_params(params[PARAM_F_ATTACK], params[PARAM_F_DECAY],
+                                    params[PARAM_F_SUSTAIN], params[PARAM_F_RELEASE]);
+    }
+    if (dirty & PARAM_BIT(PARAM_RESONANCE)) {
+        int16_t reso_val = (int16_t)(params[PARAM_RESONANCE] * 32767.0f);
+        inst->svf_damp = stmlib::Interpolate824(braids::lut_svf_damp, (uint32_t)reso_val << 17);
     }
+    return dirty;
+}
 
-    plugin_log("Braids v2: Instance created");
-    return inst;
+/* Bytes per voice slot on a side playing shape */
+static size_t arena_stride_for(const braids_instance_t *inst, int shape) {
+    size_t need = inst->arena_packed
+        ? braids::MacroOscillator::DelayLinesSize((braids::MacroOscillatorShape)shape)
+        : sizeof(braids::DigitalOscillatorDelayLines);
+    return (need + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
 }
 
-/* v2 API: Destroy instance */
+static uint8_t *arena_slot(braids_instance_t *inst, int side, int vi) {
+    return inst->state_arena + side * STATE_ARENA_SIDE + vi * inst->arena_stride[side];
+}
+
+/* Point every voice's side oscillator at its slot in that side's half */
+static void carve_arena_side(braids_instance_t *inst, int side, size_t stride) {
+    inst->arena_stride[side] = stride;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        inst->voices[i].osc[side].set_delay_lines(stride
+            ? (braids::DigitalOscillatorDelayLines*)arena_slot(inst, side, i) : NULL);
+    }
+}
+
+/*
+ * Audio thread: re-carve a side whose slot size no longer matches its
+ * engine. Engine switches carve the new side themselves and clear slots
+ * voice by voice (engine_switch_voice), so this only does work when
+ * state_arena is toggled; the side is cleared so no voice reads another
+ * layout's delay line contents.
+ */
+static void carve_state_arena(braids_instance_t *inst) {
+    for (int side = 0; side < 2; side++) {
+        size_t stride = arena_stride_for(inst, inst->side_shape[side]);
+        if (inst->arena_carved && stride == inst->arena_stride[side]) continue;
+        memset(inst->state_arena + side * STATE_ARENA_SIDE, 0, stride * MAX_VOICES);
+        carve_arena_side(inst, side, stride);
+    }
+    inst->arena_carved = 1;
+}
+
+/*
+ * Audio thread: move a voice onto the current engine side. Its slot there
+ * is cleared (only as far as the engine uses it) and the engine struck; with
+ * fade the old side plays on under a crossfade, otherwise (a new note) the
+ * voice starts on the new engine outright.
+ */
+static void engine_switch_voice(braids_instance_t *inst, int vi, int fade) {
+    BraidsVoice *v = &inst->voices[vi];
+    int side = inst->engine_side;
+    braids::MacroOscillatorShape shape = (braids::MacroOscillatorShape)inst->engine_shape;
+    braids::MacroOscillator *osc = &v->osc[side];
+
+    memset(arena_slot(inst, side, vi), 0, braids::MacroOscillator::DelayLinesSize(shape));
+    osc->set_shape(shape);
+    osc->Strike();
+    unison_bank_reset(&v->unison[side]);
+    halfband_reset(&v->halfband[side]);
+    v->side = side;
+    v->engine_gen = inst->engine_gen;
+    v->fade_pos = fade ? 0 : ENGINE_FADE_SAMPLES;
+}
+
+/*
+ * Audio thread: start a switch when the engine param has moved and the
+ * previous switch is done, then let up to ENGINE_SWITCH_VOICES more
+ * sounding voices start their crossfade. Silent voices switch when struck.
+ */
+static void engine_switch_update(braids_instance_t *inst) {
+    int target = clamp_shape(inst->dsp_params[PARAM_ENGINE]);
+    if (target != inst->engine_shape && !inst->engine_switching) {
+        int side = inst->engine_side ^ 1;
+        inst->engine_side = side;
+        inst->engine_shape = target;
+        inst->side_shape[side] = target;
+        inst->engine_gen++;
+        carve_arena_side(inst, side, arena_stride_for(inst, target));
+        inst->engine_switching = 1;
+    }
+    if (!inst->engine_switching) return;
+
+    int started = 0;
+    int pending = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        BraidsVoice *v = &inst->voices[i];
+        if (!v->active) continue;
+        if (v->engine_gen != inst->engine_gen) {
+            if (started == ENGINE_SWITCH_VOICES) {
+                pending++;
+                continue;
+            }
+            engine_switch_voice(inst, i, 1);
+            started++;
+        }
+        if (v->fade_pos < ENGINE_FADE_SAMPLES) pending++;
+    }
+    inst->engine_switching = pending > 0;
+}
+
+/* v2 API: Create instance */
+static void* v2_create_instance(const char *module_dir, const char *json_defaults) {
+    (void)json_defaults;
+
+    /* Voices are cache-line aligned, so the instance must be too */
+    void *mem = NULL;
+    if (posix_memalign(&mem, alignof(braids_instance_t), sizeof(braids_instance_t)) != 0) {
+        return NULL;
+    }
+    braids_instance_t *inst = (braids_instance_t*)memset(mem, 0, sizeof(braids_instance_t));
+
+    /* Reserved for the worst case so the audio thread never allocates */
+    if (posix_memalign((void**)&inst->state_arena, CACHE_LINE_SIZE,
+                       STATE_ARENA_SIDE * 2) != 0) {
+        free(inst);
+        return NULL;
+    }
+    strncpy(inst->module_dir, module_dir, sizeof(inst->module_dir) - 1);
+
+    /* Default parameters */
+    memcpy(inst->params, g_param_defaults, sizeof(inst->params));
+    inst->voice_counter = 0;
+    inst->current_preset = 0;
+    snprintf(inst->preset_name, sizeof(inst->preset_name), "Init");
+    inst->param_gen = 1;  /* state_gen = 0: first query builds the cache */
+    inst->settings[SETTING_RENDER_MODE] = RENDER_MODE_LANES;
+    inst->settings[SETTING_FILTER_PERIOD] = FILTER_CONTROL_PERIOD;
+    inst->settings[SETTING_OSC_BLOCK] = OSC_BLOCK_DEFAULT;
+    inst->settings[SETTING_CLIP] = VOICE_LANES_CLIP_HARD;
+    inst->settings[SETTING_SILENCE_LEVEL] = dbfs_to_level(SILENCE_THRESHOLD_DEFAULT);
+    inst->settings[SETTING_QUALITY_BUDGET] = 0.0f;
+    inst->settings[SETTING_OCTAVE_TRANSPOSE] = 0.0f;
+    inst->settings[SETTING_MAX_VOICES] = MAX_VOICES;
+    inst->settings[SETTING_VOICE_BUDGET] = VOICE_BUDGET_DEFAULT;
+    inst->settings[SETTING_STATE_ARENA] = 1.0f;
+    inst->silence_db = SILENCE_THRESHOLD_DEFAULT;
+    inst->vm.limit = DEFAULT_VOICES;
+    inst->vm.gain_voices = (float)DEFAULT_VOICES;
+    for (int i = 0; i < SETTING_COUNT; i++) apply_setting(inst, i, inst->settings[i]);
+    inst->quality = QUALITY_NORMAL;
+    inst->quality_active = QUALITY_NORMAL;
+    inst->quality_asked = QUALITY_NORMAL;
+#if BRAIDS_PERF_STATS
+    inst->perf_budget_pct = 100.0f;
+#endif
+
+    /* Init all voices */
+    for (int i = 0; i < MAX_VOICES; i++) {
+        inst->voices[i].osc[0].Init();
+        inst->voices[i].osc[1].Init();
+        inst->voices[i].pitch = inst->voices[i].osc[0].pitch();
+        inst->voices[i].side = 0;
+        inst->voices[i].fade_pos = ENGINE_FADE_SAMPLES;
+        inst->voices[i].engine_gen = 0;
+        inst->voices[i].amp_env.init();
+        inst->voices[i].filt_env.init();
+        inst->voices[i].svf.Init();
+        inst->voices[i].active = 0;
+        inst->voices[i].gate = 0;
+        inst->voices[i].note = 0;
+        inst->voices[i].velocity = 0;
+        inst->voices[i].age = 0;
+        inst->voices[i].retiring = 0;
+        inst->voices[i].quiet = 0;
+        memset(inst->voices[i].osc_buffer, 0, sizeof(inst->voices[i].osc_buffer));
+        memset(inst->voices[i].osc_out, 0, sizeof(inst->voices[i].osc_out));
+        inst->voices[i].fifo_count = 0;
+        inst->voices[i].rng_state = 0x21 + (uint32_t)i * 0x9e3779b9u;
+    }
+
+    /* Presets are parsed once per module directory and shared */
+    inst->preset_lib = preset_library_acquire(inst->module_dir);
+    if (preset_library_load(inst->preset_lib) > 0) {
+        inst->current_preset = 0;
+        v2_apply_preset(inst, 0);
+    }
+
+    /* The audio thread starts from the initial params, unsmoothed */
+    memcpy(inst->dsp_params, inst->params, sizeof(inst->params));
+    inst->smooth_coef = 1.0f - expf(-1.0f / (PARAM_SMOOTH_TIME * MOVE_SAMPLE_RATE));
+    for (int k = 0; k < SMOOTH_COUNT; k++) {
+        inst->smooth_state[k] = inst->dsp_params[g_smoothed_params[k]];
+    }
+    inst->dsp_dirty = ALL_PARAM_BITS;
+    update_param_caches(inst);
+    inst->engine_shape = clamp_shape(inst->dsp_params[PARAM_ENGINE]);
+    inst->side_shape[0] = inst->side_shape[1] = inst->engine_shape;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        inst->voices[i].osc[0].set_shape((braids::MacroOscillatorShape)inst->engine_shape);
+    }
+    carve_state_arena(inst);
+
+    plugin_log("Braids v2: Instance created");
+    log_flush();
+    return inst;
+}
+
+static void pipeline_wait(braids_instance_t *inst);
+
+/* v2 API: Destroy instance */
 static void v2_destroy_instance(void *instance) {
     braids_instance_t *inst = (braids_instance_t*)instance;
     if (!inst) return;
+    pipeline_wait(inst);
+    worker_pool_release(inst->pool);
+    preset_library_release(inst->preset_lib);
+    free(inst->state_arena);
     free(inst);
     plugin_log("Braids v2: Instance destroyed");
+    log_flush();
 }
 
-/* v2 API: MIDI handler */
-static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source) {
-    braids_instance_t *inst = (braids_instance_t*)instance;
-    if (!inst || len < 2) return;
-    (void)source;
-
+/* Apply one MIDI message to the voices (render thread) */
+static void handle_midi(braids_instance_t *inst, const uint8_t *msg, int len) {
     uint8_t status = msg[0] & 0xF0;
     uint8_t data1 = msg[1];
     uint8_t data2 = (len > 2) ? msg[2] : 0;
@@ -601,10 +1563,18 @@ static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source)
                 v->velocity = data2;
                 v->active = 1;
                 v->gate = 1;
+                v->retiring = 0;
+                v->quiet = 0;
+                v->fifo_count = 0;  /* Drop samples rendered ahead for the old note */
+                if (v->engine_gen != inst->engine_gen) engine_switch_voice(inst, vi, 0);
+                v->fade_pos = ENGINE_FADE_SAMPLES;  /* A new note does not fade */
+                unison_bank_reset(&v->unison[v->side]);
+                halfband_reset(&v->halfband[v->side]);
                 v->age = ++inst->voice_counter;
-                v->osc.set_pitch(note_to_pitch(note));
+                voice_start_glide(inst, v);
+                v->pitch = note_to_pitch(note);
                 apply_params_to_voice(inst, v);
-                v->osc.Strike();
+                v->osc[v->side].Strike();
                 v->amp_env.gate_on();
                 v->filt_env.gate_on();
             } else {
@@ -631,9 +1601,13 @@ static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source)
 
         case 0xB0: /* CC */
             switch (data1) {
-                case 1: /* Mod wheel -> FM amount */
-                    inst->params[PARAM_FM] = data2 / 127.0f;
+                case 1: { /* Mod wheel -> FM amount (MIDI arrives on the audio thread) */
+                    inst->dsp_params[PARAM_FM] = data2 / 127.0f;
+                    uint32_t count = (__atomic_load_n(&inst->midi_fm, __ATOMIC_RELAXED) >> 8) + 1;
+                    __atomic_store_n(&inst->midi_fm, (count << 8) | (uint32_t)data2,
+                                     __ATOMIC_RELEASE);
                     break;
+                }
             }
             break;
 
@@ -641,353 +1615,1512 @@ static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source)
             {
                 int bend = ((data2 << 7) | data1) - 8192;
                 float bend_semitones = (bend / 8192.0f) * 2.0f; /* +/- 2 semitones */
-                /* Apply to all active voices */
-                for (int i = 0; i < MAX_VOICES; i++) {
-                    if (inst->voices[i].active) {
-                        int16_t pitch = note_to_pitch(inst->voices[i].note);
-                        pitch += (int16_t)(bend_semitones * 128.0f);
-                        inst->voices[i].osc.set_pitch(pitch);
-                    }
-                }
+                /* Applied to all voices as their next chunk's pitch is set */
+                inst->pitch_bend = (int32_t)(bend_semitones * 128.0f);
             }
             break;
     }
 }
 
-/* v2 API: Set parameter */
-static void v2_set_param(void *instance, const char *key, const char *val) {
+/* v2 API: MIDI handler */
+static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source) {
     braids_instance_t *inst = (braids_instance_t*)instance;
-    if (!inst) return;
+    if (!inst || len < 2) return;
+    (void)source;
+    RT_WATCH_SCOPE();
+
+    /*
+     * Timed messages wait for render_block to place them in the block. So
+     * does anything arriving while voices may still be rendering the
+     * pipelined block: it would only take effect at the next block anyway.
+     * A full queue is applied on the spot, after the batch if need be.
+     */
+    int timing = __atomic_load_n(&inst->midi_timing, __ATOMIC_RELAXED);
+    if (timing != MIDI_TIMING_BLOCK || inst->pipeline_inflight) {
+        if (inst->midi_event_count < MIDI_EVENT_MAX) {
+            MidiEvent *e = &inst->midi_events[inst->midi_event_count++];
+            e->time = perf_now();
+            e->len = (uint8_t)(len > 3 ? 3 : len);
+            memcpy(e->msg, msg, e->len);
+            return;
+        }
+        pipeline_wait(inst);
+    }
+    for (int i = 0; i < inst->midi_event_count; i++) {
+        handle_midi(inst, inst->midi_events[i].msg, inst->midi_events[i].len);
+    }
+    inst->midi_event_count = 0;
+    handle_midi(inst, msg, len);
+}
 
-    /* State restore from patch save */
-    if (strcmp(key, "state") == 0) {
-        char logbuf[256];
-        snprintf(logbuf, sizeof(logbuf), "set_param state: %.200s", val ? val : "(null)");
-        plugin_log(logbuf);
+/* =====================================================================
+ * Parameter key dispatch
+ * ===================================================================== */
 
-        float fval;
+/* Every key get/set_param understands; shadow params follow KEY_SHADOW_BASE */
+enum ParamKey {
+    KEY_NAME = 0,
+    KEY_STATE,
+    KEY_PARAMS,
+    KEY_PRESET,
+    KEY_PRESET_COUNT,
+    KEY_PRESET_NAME,
+    KEY_ENGINE,
+    KEY_ENGINE_NAME,
+    KEY_OCTAVE_TRANSPOSE,
+    KEY_UI_HIERARCHY,
+    KEY_CHAIN_PARAMS,
+    KEY_RENDER_MODE,
+    KEY_FILTER_RATE,
+    KEY_OSC_BLOCK,
+    KEY_LATENCY,
+    KEY_MAX_VOICES,
+    KEY_VOICE_BUDGET,
+    KEY_VOICE_LIMIT,
+    KEY_STATE_ARENA,
+    KEY_MEMORY,
+    KEY_THREADING,
+    KEY_WORKER_THREADS,
+    KEY_MIDI_TIMING,
+    KEY_CLIP,
+    KEY_SILENCE_THRESHOLD,
+    KEY_QUALITY,
+    KEY_QUALITY_BUDGET,
+    KEY_QUALITY_ACTIVE,
+    KEY_PERF_STATS,
+    KEY_PERF_BUDGET,
+    KEY_PERF_RESET,
+    KEY_LOG,
+    KEY_RT_WATCHDOG,
+    KEY_SHADOW_BASE
+};
 
-        /* Restore preset first (sets all params to preset values) */
-        if (json_get_number(val, "preset", &fval) == 0) {
-            int idx = (int)fval;
-            if (idx >= 0 && idx < inst->preset_count) {
-                inst->current_preset = idx;
-                v2_apply_preset(inst, idx);
-            }
-        }
+static const struct {
+    const char *key;
+    int id;
+} g_special_keys[] = {
+    {"name",             KEY_NAME},
+    {"state",            KEY_STATE},
+    {"params",           KEY_PARAMS},
+    {"preset",           KEY_PRESET},
+    {"preset_count",     KEY_PRESET_COUNT},
+    {"preset_name",      KEY_PRESET_NAME},
+    {"engine",           KEY_ENGINE},
+    {"engine_name",      KEY_ENGINE_NAME},
+    {"octave_transpose", KEY_OCTAVE_TRANSPOSE},
+    {"ui_hierarchy",     KEY_UI_HIERARCHY},
+    {"chain_params",     KEY_CHAIN_PARAMS},
+    {"render_mode",      KEY_RENDER_MODE},
+    {"filter_rate",      KEY_FILTER_RATE},
+    {"osc_block",        KEY_OSC_BLOCK},
+    {"latency",          KEY_LATENCY},
+    {"max_voices",       KEY_MAX_VOICES},
+    {"voice_budget",     KEY_VOICE_BUDGET},
+    {"voice_limit",      KEY_VOICE_LIMIT},
+    {"state_arena",      KEY_STATE_ARENA},
+    {"memory",           KEY_MEMORY},
+    {"threading",        KEY_THREADING},
+    {"worker_threads",   KEY_WORKER_THREADS},
+    {"midi_timing",      KEY_MIDI_TIMING},
+    {"clip",             KEY_CLIP},
+    {"silence_threshold", KEY_SILENCE_THRESHOLD},
+    {"quality",          KEY_QUALITY},
+    {"quality_budget",   KEY_QUALITY_BUDGET},
+    {"quality_active",   KEY_QUALITY_ACTIVE},
+    {"perf_stats",       KEY_PERF_STATS},
+    {"perf_budget",      KEY_PERF_BUDGET},
+    {"perf_reset",       KEY_PERF_RESET},
+    {"log",              KEY_LOG},
+    {"rt_watchdog",      KEY_RT_WATCHDOG},
+};
 
-        /* Then override with any saved param values (user tweaks on top of preset) */
-        if (json_get_number(val, "octave_transpose", &fval) == 0) {
-            inst->octave_transpose = (int)fval;
-            if (inst->octave_transpose < -3) inst->octave_transpose = -3;
-            if (inst->octave_transpose > 3) inst->octave_transpose = 3;
+/* Built once in move_plugin_init_v2 */
+static param_hash_t g_key_hash;
+static param_hash_t g_engine_hash;
+
+static int build_key_hashes(void) {
+    const char *keys[PARAM_HASH_MAX_SLOTS / 2];
+    int ids[PARAM_HASH_MAX_SLOTS / 2];
+    int count = 0;
+    for (int i = 0; i < (int)(sizeof(g_special_keys) / sizeof(g_special_keys[0])); i++) {
+        keys[count] = g_special_keys[i].key;
+        ids[count++] = g_special_keys[i].id;
+    }
+    for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params); i++) {
+        if (g_shadow_params[i].index == PARAM_ENGINE) continue;  /* KEY_ENGINE */
+        keys[count] = g_shadow_params[i].key;
+        ids[count++] = KEY_SHADOW_BASE + i;
+    }
+    if (param_hash_build(&g_key_hash, keys, ids, count) != 0) return -1;
+    return param_hash_build(&g_engine_hash, g_shape_names, NULL, NUM_SHAPES);
+}
+
+/* Engine index from a shape name or a number */
+static float parse_engine(const char *val) {
+    int shape = param_hash_find(&g_engine_hash, val);
+    if (shape >= 0) return (float)shape;
+    float v = (float)atof(val);
+    if (v < 0) v = 0;
+    if (v >= NUM_SHAPES) v = NUM_SHAPES - 1;
+    return v;
+}
+
+static int is_number(const char *val) {
+    char *end;
+    strtod(val, &end);
+    return end != val && *end == '\0';
+}
+
+static const char *g_threading_names[] = { "off", "sync", "pipelined" };
+static const char *g_midi_timing_names[] = { "block", "spread", "clock" };
+static const char *g_clip_names[] = { "hard", "soft" };  /* VOICE_LANES_CLIP_* */
+
+/* Index of val in a name table (the enum value), -1 if unknown */
+static int parse_choice(const char *const *names, int count, const char *val) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(val, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+#define PARSE_CHOICE(names, val) \
+    parse_choice(names, (int)(sizeof(names) / sizeof(names[0])), val)
+
+/* Whether set_param would accept val for key id (used to vet "params" batches) */
+static int validate_set(int id, const char *val) {
+    switch (id) {
+        case KEY_ENGINE:
+            return param_hash_find(&g_engine_hash, val) >= 0 || is_number(val);
+        case KEY_RENDER_MODE:
+            return strcmp(val, "lanes") == 0 || strcmp(val, "scalar") == 0;
+        case KEY_THREADING:
+            return PARSE_CHOICE(g_threading_names, val) >= 0;
+        case KEY_MIDI_TIMING:
+            return PARSE_CHOICE(g_midi_timing_names, val) >= 0;
+        case KEY_CLIP:
+            return PARSE_CHOICE(g_clip_names, val) >= 0;
+        case KEY_QUALITY:
+            return PARSE_CHOICE(g_quality_names, val) >= 0;
+        case KEY_SILENCE_THRESHOLD:
+            return strcmp(val, "off") == 0 || is_number(val);
+        case KEY_PERF_RESET:
+            return 1;
+        case KEY_PRESET:
+        case KEY_OCTAVE_TRANSPOSE:
+        case KEY_FILTER_RATE:
+        case KEY_OSC_BLOCK:
+        case KEY_MAX_VOICES:
+        case KEY_VOICE_BUDGET:
+        case KEY_STATE_ARENA:
+        case KEY_QUALITY_BUDGET:
+        case KEY_PERF_BUDGET:
+            return is_number(val);
+        default:
+            return id >= KEY_SHADOW_BASE && is_number(val);
+    }
+}
+
+/* Member buffers for one pass over a flat JSON object (longer ones are cut) */
+#define JSON_KEY_MAX 32
+#define JSON_VALUE_MAX 64     /* BraidsPreset name, NUL included */
+
+/*
+ * A .braids file's members, in one pass: name, engine (a shape name or a
+ * number), octave_transpose and the shadow params. Unknown keys are
+ * skipped; params left out keep their defaults.
+ */
+static void parse_preset_json(BraidsPreset *p, int index, const char *json) {
+    memset(p, 0, sizeof(BraidsPreset));
+    memcpy(p->params, g_param_defaults, sizeof(p->params));
+    snprintf(p->name, sizeof(p->name), "Preset %d", index);
+
+    char key[JSON_KEY_MAX], val[JSON_VALUE_MAX];
+    const char *pos = json;
+    while (param_json_next(&pos, key, sizeof(key), val, sizeof(val)) == 1) {
+        int id = param_hash_find(&g_key_hash, key);
+        if (id == KEY_NAME) {
+            snprintf(p->name, sizeof(p->name), "%s", val);
+        } else if (id == KEY_ENGINE) {
+            p->params[PARAM_ENGINE] = parse_engine(val);
+        } else if (id == KEY_OCTAVE_TRANSPOSE) {
+            int octave = atoi(val);
+            p->octave_transpose = octave < -3 ? -3 : octave > 3 ? 3 : octave;
+        } else if (id >= KEY_SHADOW_BASE) {
+            p->params[g_shadow_params[id - KEY_SHADOW_BASE].index] = (float)atof(val);
         }
-        for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params); i++) {
-            if (json_get_number(val, g_shadow_params[i].key, &fval) == 0) {
-                if (fval < g_shadow_params[i].min_val) fval = g_shadow_params[i].min_val;
-                if (fval > g_shadow_params[i].max_val) fval = g_shadow_params[i].max_val;
-                inst->params[g_shadow_params[i].index] = fval;
-            }
+    }
+}
+
+/*
+ * "state": one pass collects the members, then the preset (if any) is
+ * applied and the saved params override it (user tweaks on top of preset)
+ */
+static void restore_state(braids_instance_t *inst, const char *val) {
+    plugin_logf("set_param state: %.200s", val ? val : "(null)");
+    if (!val) return;
+
+    float values[PARAM_COUNT];
+    uint32_t seen = 0;
+    int preset = -1;
+    int octave = 0, has_octave = 0;
+
+    char key[JSON_KEY_MAX], member[JSON_VALUE_MAX];
+    const char *pos = val;
+    while (param_json_next(&pos, key, sizeof(key), member, sizeof(member)) == 1) {
+        int id = param_hash_find(&g_key_hash, key);
+        if (id == KEY_PRESET) {
+            preset = atoi(member);
+        } else if (id == KEY_OCTAVE_TRANSPOSE) {
+            octave = atoi(member);
+            has_octave = 1;
+        } else if (id == KEY_ENGINE) {
+            values[PARAM_ENGINE] = parse_engine(member);
+            seen |= PARAM_BIT(PARAM_ENGINE);
+        } else if (id >= KEY_SHADOW_BASE) {
+            const param_def_t *def = &g_shadow_params[id - KEY_SHADOW_BASE];
+            float fval = (float)atof(member);
+            if (fval < def->min_val) fval = def->min_val;
+            if (fval > def->max_val) fval = def->max_val;
+            values[def->index] = fval;
+            seen |= PARAM_BIT(def->index);
         }
-        return;
     }
 
-    if (strcmp(key, "octave_transpose") == 0) {
-        inst->octave_transpose = atoi(val);
-        if (inst->octave_transpose < -3) inst->octave_transpose = -3;
-        if (inst->octave_transpose > 3) inst->octave_transpose = 3;
-        return;
+    if (preset >= 0 && preset < preset_count(inst)) {
+        inst->current_preset = preset;
+        v2_apply_preset(inst, preset);
+    }
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        if (seen & PARAM_BIT(i)) inst->params[i] = values[i];
+    }
+    params_changed(inst);
+    publish_all_params(inst);
+    if (has_octave) {
+        set_setting(inst, SETTING_OCTAVE_TRANSPOSE,
+                    (float)(octave < -3 ? -3 : octave > 3 ? 3 : octave));
     }
+}
 
-    /* Preset selection */
-    if (strcmp(key, "preset") == 0) {
-        int idx = atoi(val);
-        if (idx >= 0 && idx < inst->preset_count && idx != inst->current_preset) {
-            /* Kill all active voices to avoid hanging notes with mismatched params */
-            for (int i = 0; i < MAX_VOICES; i++) {
-                inst->voices[i].active = 0;
-                inst->voices[i].gate = 0;
-                inst->voices[i].amp_env.init();
-                inst->voices[i].filt_env.init();
-            }
-            inst->current_preset = idx;
-            v2_apply_preset(inst, idx);
+static void set_param_id(braids_instance_t *inst, int id, const char *val);
+
+/*
+ * "params": a flat JSON object of key/value pairs, e.g.
+ * {"engine":"FM","timbre":0.4,"cutoff":0.7}. The whole batch is parsed and
+ * validated first; nothing is applied if any member is unknown or malformed.
+ */
+#define PARAMS_BATCH_MAX 64
+
+static void set_params_batch(braids_instance_t *inst, const char *json) {
+    /* One spare member: a batch is too long only if it has one past the limit */
+    int ids[PARAMS_BATCH_MAX + 1];
+    char keys[PARAMS_BATCH_MAX + 1][JSON_KEY_MAX];
+    char vals[PARAMS_BATCH_MAX + 1][JSON_VALUE_MAX];
+    int count = 0;
+    const char *pos = json;
+    while (*pos == ' ') pos++;
+    if (*pos != '{') { plugin_log("params: expected a JSON object"); return; }
+
+    int r;
+    while (count <= PARAMS_BATCH_MAX &&
+           (r = param_json_next(&pos, keys[count], sizeof(keys[count]),
+                                vals[count], sizeof(vals[count]))) == 1) {
+        int id = param_hash_find(&g_key_hash, keys[count]);
+        if (id < 0 || id == KEY_STATE || id == KEY_PARAMS || !validate_set(id, vals[count])) {
+            plugin_logf("params: rejected batch at \"%.*s\":\"%.*s\"",
+                        JSON_KEY_MAX - 1, keys[count], JSON_VALUE_MAX - 1, vals[count]);
+            return;
         }
+        ids[count++] = id;
+    }
+    if (count > PARAMS_BATCH_MAX || r < 0) {
+        plugin_log(r < 0 ? "params: malformed JSON object" : "params: too many members");
         return;
     }
 
-    /* Engine: accept name string or numeric index */
-    if (strcmp(key, "engine") == 0) {
-        /* Try name lookup first */
-        for (int i = 0; i < NUM_SHAPES; i++) {
-            if (strcmp(val, g_shape_names[i]) == 0) {
-                inst->params[PARAM_ENGINE] = (float)i;
+    for (int i = 0; i < count; i++) set_param_id(inst, ids[i], vals[i]);
+}
+
+static void set_param_id(braids_instance_t *inst, int id, const char *val) {
+    switch (id) {
+        case KEY_STATE:
+            restore_state(inst, val);
+            return;
+        case KEY_PARAMS:
+            set_params_batch(inst, val);
+            return;
+        case KEY_RENDER_MODE:
+            set_setting(inst, SETTING_RENDER_MODE, (strcmp(val, "scalar") == 0)
+                        ? RENDER_MODE_SCALAR : RENDER_MODE_LANES);
+            return;
+        case KEY_FILTER_RATE: {
+            int period = atoi(val);
+            if (period < 1) period = 1;
+            if (period > MOVE_FRAMES_PER_BLOCK) period = MOVE_FRAMES_PER_BLOCK;
+            set_setting(inst, SETTING_FILTER_PERIOD, (float)period);
+            return;
+        }
+        case KEY_OSC_BLOCK: {
+            int size = atoi(val);
+            if (size == 24 || size == 32 || size == 64) set_setting(inst, SETTING_OSC_BLOCK, (float)size);
+            return;
+        }
+        case KEY_MAX_VOICES: {
+            int n = atoi(val);
+            if (n < 1) n = 1;
+            if (n > MAX_VOICES) n = MAX_VOICES;
+            set_setting(inst, SETTING_MAX_VOICES, (float)n);
+            return;
+        }
+        case KEY_VOICE_BUDGET: {
+            float pct = (float)atof(val);
+            if (pct < 0.0f) pct = 0.0f;
+            if (pct > 100.0f) pct = 100.0f;
+            set_setting(inst, SETTING_VOICE_BUDGET, pct);
+            return;
+        }
+        case KEY_STATE_ARENA:
+            /* Applied by the render thread at the start of the next block */
+            set_setting(inst, SETTING_STATE_ARENA, atoi(val) ? 1.0f : 0.0f);
+            return;
+        case KEY_THREADING: {
+            int mode = PARSE_CHOICE(g_threading_names, val);
+            if (mode < 0) return;
+            /* Workers start on first use and stay until the instance goes */
+            if (mode != THREADING_OFF && !inst->pool) {
+                __atomic_store_n(&inst->pool, worker_pool_acquire(), __ATOMIC_RELEASE);
+            }
+            __atomic_store_n(&inst->threading, mode, __ATOMIC_RELEASE);
+            return;
+        }
+        case KEY_MIDI_TIMING: {
+            int timing = PARSE_CHOICE(g_midi_timing_names, val);
+            if (timing >= 0) __atomic_store_n(&inst->midi_timing, timing, __ATOMIC_RELAXED);
+            return;
+        }
+        case KEY_CLIP: {
+            int clip = PARSE_CHOICE(g_clip_names, val);
+            if (clip >= 0) set_setting(inst, SETTING_CLIP, (float)clip);
+            return;
+        }
+        case KEY_SILENCE_THRESHOLD: {
+            if (strcmp(val, "off") == 0) {
+                set_setting(inst, SETTING_SILENCE_LEVEL, 0.0f);
                 return;
             }
+            float db = (float)atof(val);
+            if (db < SILENCE_THRESHOLD_MIN) db = SILENCE_THRESHOLD_MIN;
+            if (db > SILENCE_THRESHOLD_MAX) db = SILENCE_THRESHOLD_MAX;
+            inst->silence_db = db;
+            set_setting(inst, SETTING_SILENCE_LEVEL, dbfs_to_level(db));
+            return;
         }
-        /* Fall through to numeric */
-        float v = (float)atof(val);
-        if (v < 0) v = 0;
-        if (v >= NUM_SHAPES) v = NUM_SHAPES - 1;
-        inst->params[PARAM_ENGINE] = v;
-        return;
+        case KEY_QUALITY: {
+            /* The render thread moves quality_active to it */
+            int quality = PARSE_CHOICE(g_quality_names, val);
+            if (quality >= 0) __atomic_store_n(&inst->quality, quality, __ATOMIC_RELAXED);
+            return;
+        }
+        case KEY_QUALITY_BUDGET: {
+            float pct = (float)atof(val);
+            if (pct < 0.0f) pct = 0.0f;
+            if (pct > 100.0f) pct = 100.0f;
+            set_setting(inst, SETTING_QUALITY_BUDGET, pct);
+            return;
+        }
+#if BRAIDS_PERF_STATS
+        /* Instrumentation: reset is applied by the render thread */
+        case KEY_PERF_RESET:
+            inst->perf_reset_pending = 1;
+            return;
+        case KEY_PERF_BUDGET: {
+            float pct = (float)atof(val);
+            if (pct < 1.0f) pct = 1.0f;
+            if (pct > 1000.0f) pct = 1000.0f;
+            inst->perf_budget_pct = pct;
+            return;
+        }
+#endif
+        case KEY_OCTAVE_TRANSPOSE: {
+            int octave = atoi(val);
+            if (octave < -3) octave = -3;
+            if (octave > 3) octave = 3;
+            set_setting(inst, SETTING_OCTAVE_TRANSPOSE, (float)octave);
+            params_changed(inst);
+            return;
+        }
+
+        /* Preset selection */
+        case KEY_PRESET: {
+            int idx = atoi(val);
+            if (idx >= 0 && idx < preset_count(inst) && idx != inst->current_preset) {
+                /* Kill all active voices to avoid hanging notes with mismatched params */
+                publish_voice_reset(inst);
+                inst->current_preset = idx;
+                v2_apply_preset(inst, idx);
+            }
+            return;
+        }
+
+        /* Engine: accept name string or numeric index */
+        case KEY_ENGINE:
+            inst->params[PARAM_ENGINE] = parse_engine(val);
+            params_changed(inst);
+            publish_param(inst, PARAM_ENGINE);
+            return;
+
+        default:
+            break;
     }
 
     /* Named parameter access */
-    float fval = (float)atof(val);
+    if (id >= KEY_SHADOW_BASE) {
+        const param_def_t *def = &g_shadow_params[id - KEY_SHADOW_BASE];
+        float fval = (float)atof(val);
+        if (fval < def->min_val) fval = def->min_val;
+        if (fval > def->max_val) fval = def->max_val;
+        inst->params[def->index] = fval;
+        params_changed(inst);
+        publish_param(inst, def->index);
+    }
+}
+
+/* v2 API: Set parameter */
+static void v2_set_param(void *instance, const char *key, const char *val) {
+    braids_instance_t *inst = (braids_instance_t*)instance;
+    if (!inst || !key || !val) return;
+    take_midi_params(inst);
+    set_param_id(inst, param_hash_find(&g_key_hash, key), val);
+}
+
+/* Serialise render-time statistics for get_param("perf_stats") */
+static int perf_stats_json(braids_instance_t *inst, char *buf, int buf_len) {
+#if BRAIDS_PERF_STATS
+    const BraidsPerf *perf = &inst->perf;
+    uint64_t realtime_ticks = (uint64_t)MOVE_FRAMES_PER_BLOCK * g_perf_ticks_per_sec
+                              / MOVE_SAMPLE_RATE;
+    double us_per_tick = 1e6 / (double)g_perf_ticks_per_sec;
+
+    int offset = snprintf(buf, buf_len,
+        "{\"enabled\":true,\"tick_hz\":%llu,\"budget_pct\":%.1f,\"realtime_us\":%.1f,",
+        (unsigned long long)g_perf_ticks_per_sec, inst->perf_budget_pct,
+        realtime_ticks * us_per_tick);
+    if (offset >= buf_len) return -1;
+    int len = perf_block_json(&perf->block, g_perf_ticks_per_sec, realtime_ticks,
+                              buf + offset, buf_len - offset);
+    if (len < 0) return -1;
+    offset += len;
+
+    double post_avg = perf->block.blocks
+        ? (double)perf->post_ticks / (double)perf->block.blocks : 0.0;
+    offset += snprintf(buf + offset, buf_len - offset,
+        ",\"post_last_us\":%.1f,\"post_avg_us\":%.1f,\"silence_retired\":%llu,"
+        "\"quality\":\"%s\",\"quality_steps\":%llu,\"voices\":[",
+        perf->post_last * us_per_tick, post_avg * us_per_tick,
+        (unsigned long long)perf->silence_retired, g_quality_names[inst->quality_active],
+        (unsigned long long)perf->quality_steps);
+    for (int i = 0; i < MAX_VOICES && offset < buf_len; i++) {
+        double avg = perf->voice_blocks[i]
+            ? (double)perf->voice_ticks[i] / (double)perf->voice_blocks[i] : 0.0;
+        offset += snprintf(buf + offset, buf_len - offset,
+            "%s{\"active\":%d,\"last_us\":%.1f,\"avg_us\":%.1f}",
+            i ? "," : "", inst->voices[i].active,
+            perf->voice_last[i] * us_per_tick, avg * us_per_tick);
+    }
+
+    /* Only engines that have actually rendered */
+    if (offset < buf_len) offset += snprintf(buf + offset, buf_len - offset, "],\"engines\":[");
+    int first = 1;
+    for (int i = 0; i < NUM_SHAPES && offset < buf_len; i++) {
+        if (!perf->engine_blocks[i]) continue;
+        double avg = (double)perf->engine_ticks[i] / (double)perf->engine_blocks[i];
+        offset += snprintf(buf + offset, buf_len - offset, "%s{\"engine\":\"",
+                           first ? "" : ",");
+        for (const char *p = g_shape_names[i]; *p && offset < buf_len - 2; p++) {
+            if (*p == '\\' || *p == '"') buf[offset++] = '\\';
+            buf[offset++] = *p;
+        }
+        if (offset < buf_len) {
+            offset += snprintf(buf + offset, buf_len - offset,
+                "\",\"voice_blocks\":%llu,\"avg_us\":%.1f}",
+                (unsigned long long)perf->engine_blocks[i], avg * us_per_tick);
+        }
+        first = 0;
+    }
+    if (offset < buf_len) offset += snprintf(buf + offset, buf_len - offset, "]}");
+    if (offset >= buf_len) return -1;
+    return offset;
+#else
+    (void)inst;
+    return snprintf(buf, buf_len, "{\"enabled\":false}");
+#endif
+}
+
+/* =====================================================================
+ * Cached metadata and state
+ * ===================================================================== */
+
+/* UI hierarchy for the shadow parameter editor (static) */
+static const char g_ui_hierarchy[] = "{"
+        "\"modes\":null,"
+        "\"levels\":{"
+            "\"root\":{"
+                "\"list_param\":\"preset\","
+                "\"count_param\":\"preset_count\","
+                "\"name_param\":\"preset_name\","
+                "\"children\":null,"
+                "\"knobs\":[\"engine\",\"timbre\",\"color\",\"attack\",\"decay\",\"sustain\",\"cutoff\",\"filt_env\"],"
+                "\"params\":["
+                    "{\"level\":\"oscillator\",\"label\":\"Oscillator\"},"
+                    "{\"level\":\"envelope\",\"label\":\"Amp Envelope\"},"
+                    "{\"level\":\"filter\",\"label\":\"Filter\"},"
+                    "{\"level\":\"global\",\"label\":\"Global\"}"
+                "]"
+            "},"
+            "\"oscillator\":{"
+                "\"children\":null,"
+                "\"knobs\":[\"engine\",\"timbre\",\"color\",\"fm\"],"
+                "\"params\":[\"engine\",\"timbre\",\"color\",\"fm\",\"unison\",\"unison_spread\",\"glide\"]"
+            "},"
+            "\"envelope\":{"
+                "\"children\":null,"
+                "\"knobs\":[\"attack\",\"decay\",\"sustain\",\"release\"],"
+                "\"params\":[\"attack\",\"decay\",\"sustain\",\"release\"]"
+            "},"
+            "\"filter\":{"
+                "\"children\":null,"
+                "\"knobs\":[\"cutoff\",\"resonance\",\"filt_env\",\"f_attack\",\"f_decay\",\"f_sustain\",\"f_release\"],"
+                "\"params\":[\"cutoff\",\"resonance\",\"filt_env\",\"f_attack\",\"f_decay\",\"f_sustain\",\"f_release\"]"
+            "},"
+            "\"global\":{"
+                "\"children\":null,"
+                "\"knobs\":[\"volume\",\"octave_transpose\"],"
+                "\"params\":[\"volume\",\"octave_transpose\"]"
+            "}"
+        "}"
+    "}";
+
+/* chain_params never changes at runtime: serialised once in move_plugin_init_v2 */
+static char g_chain_params[4096];
+static int g_chain_params_len = -1;
+
+/* Copy a pre-serialised response. Returns: length, or -1 if it does not fit */
+static int copy_cached(char *buf, int buf_len, const char *src, int len) {
+    if (len < 0 || len >= buf_len) return -1;
+    memcpy(buf, src, len + 1);
+    return len;
+}
+
+static int build_chain_params_json(char *buf, int buf_len) {
+    int offset = 0;
+    offset += snprintf(buf + offset, buf_len - offset, "[");
+
+    /* Engine as enum with all algorithm names */
+    offset += snprintf(buf + offset, buf_len - offset,
+        "{\"key\":\"engine\",\"name\":\"Algorithm\",\"type\":\"enum\",\"options\":[");
+    for (int i = 0; i < NUM_SHAPES && offset < buf_len - 50; i++) {
+        if (i > 0) offset += snprintf(buf + offset, buf_len - offset, ",");
+        /* Write JSON-escaped string (backslash needs escaping) */
+        buf[offset++] = '"';
+        for (const char *p = g_shape_names[i]; *p && offset < buf_len - 10; p++) {
+            if (*p == '\\' || *p == '"') buf[offset++] = '\\';
+            buf[offset++] = *p;
+        }
+        buf[offset++] = '"';
+        buf[offset] = '\0';
+    }
+    offset += snprintf(buf + offset, buf_len - offset, "]}");
+
+    /* Remaining params */
+    for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params) && offset < buf_len - 100; i++) {
+        if (strcmp(g_shadow_params[i].key, "engine") == 0) continue;  /* Already handled */
+        /* Float params with 0-1 range get percentage display */
+        int is_pct = (g_shadow_params[i].type == PARAM_TYPE_FLOAT &&
+                      g_shadow_params[i].min_val == 0.0f &&
+                      g_shadow_params[i].max_val == 1.0f);
+        offset += snprintf(buf + offset, buf_len - offset,
+            ",{\"key\":\"%s\",\"name\":\"%s\",\"type\":\"%s\",\"min\":%g,\"max\":%g%s}",
+            g_shadow_params[i].key,
+            g_shadow_params[i].name[0] ? g_shadow_params[i].name : g_shadow_params[i].key,
+            g_shadow_params[i].type == PARAM_TYPE_INT ? "int" : "float",
+            g_shadow_params[i].min_val,
+            g_shadow_params[i].max_val,
+            is_pct ? ",\"unit\":\"%\",\"display_format\":\"%.0f\"" : "");
+    }
+
+    /* Octave transpose */
+    offset += snprintf(buf + offset, buf_len - offset,
+        ",{\"key\":\"octave_transpose\",\"name\":\"Octave\",\"type\":\"int\",\"min\":-3,\"max\":3}");
+
+    offset += snprintf(buf + offset, buf_len - offset, "]");
+    if (offset >= buf_len) return -1;
+    return offset;
+}
+
+static int build_state_json(const braids_instance_t *inst, char *buf, int buf_len) {
+    int offset = 0;
+    offset += snprintf(buf + offset, buf_len - offset,
+        "{\"preset\":%d,\"octave_transpose\":%d", inst->current_preset,
+        (int)inst->settings[SETTING_OCTAVE_TRANSPOSE]);
     for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params); i++) {
-        if (strcmp(key, g_shadow_params[i].key) == 0) {
-            if (fval < g_shadow_params[i].min_val) fval = g_shadow_params[i].min_val;
-            if (fval > g_shadow_params[i].max_val) fval = g_shadow_params[i].max_val;
-            inst->params[g_shadow_params[i].index] = fval;
-            return;
+        float val = inst->params[g_shadow_params[i].index];
+        if (g_shadow_params[i].type == PARAM_TYPE_INT) {
+            offset += snprintf(buf + offset, buf_len - offset,
+                ",\"%s\":%d", g_shadow_params[i].key, (int)val);
+        } else {
+            offset += snprintf(buf + offset, buf_len - offset,
+                ",\"%s\":%.4f", g_shadow_params[i].key, val);
         }
     }
+    offset += snprintf(buf + offset, buf_len - offset, "}");
+    if (offset >= buf_len) return -1;
+    return offset;
+}
+
+/* Blocking calls seen on the audio path, by kind (BRAIDS_RT_WATCHDOG builds) */
+static int rt_watchdog_json(char *buf, int buf_len) {
+#if BRAIDS_RT_WATCHDOG
+    int len = snprintf(buf, buf_len, "{\"enabled\":true");
+    for (int k = 0; k < RT_WATCH_KINDS && len < buf_len; k++) {
+        len += snprintf(buf + len, buf_len - len, ",\"%s\":%llu", g_rt_watch_names[k],
+                        (unsigned long long)rt_watch_count(k));
+    }
+    if (len < buf_len) len += snprintf(buf + len, buf_len - len, "}");
+    return len < buf_len ? len : -1;
+#else
+    return snprintf(buf, buf_len, "{\"enabled\":false}");
+#endif
 }
 
 /* v2 API: Get parameter */
 static int v2_get_param(void *instance, const char *key, char *buf, int buf_len) {
     braids_instance_t *inst = (braids_instance_t*)instance;
-    if (!inst) return -1;
-
-    if (strcmp(key, "name") == 0) {
-        return snprintf(buf, buf_len, "Braids");
-    }
-    if (strcmp(key, "octave_transpose") == 0) {
-        return snprintf(buf, buf_len, "%d", inst->octave_transpose);
-    }
-
-    /* Preset browser */
-    if (strcmp(key, "preset") == 0) {
-        return snprintf(buf, buf_len, "%d", inst->current_preset);
-    }
-    if (strcmp(key, "preset_count") == 0) {
-        return snprintf(buf, buf_len, "%d", inst->preset_count);
-    }
-    if (strcmp(key, "preset_name") == 0) {
-        return snprintf(buf, buf_len, "%s", inst->preset_name);
-    }
-
-    /* Engine: return name string for enum display */
-    if (strcmp(key, "engine") == 0 || strcmp(key, "engine_name") == 0) {
-        int shape = (int)inst->params[PARAM_ENGINE];
-        if (shape < 0) shape = 0;
-        if (shape >= NUM_SHAPES) shape = NUM_SHAPES - 1;
-        return snprintf(buf, buf_len, "%s", g_shape_names[shape]);
-    }
-
-    /* Named parameter access via helper */
-    int result = param_helper_get(g_shadow_params, PARAM_DEF_COUNT(g_shadow_params),
-                                  inst->params, key, buf, buf_len);
-    if (result >= 0) return result;
-
-    /* UI hierarchy for shadow parameter editor */
-    if (strcmp(key, "ui_hierarchy") == 0) {
-        const char *hierarchy = "{"
-            "\"modes\":null,"
-            "\"levels\":{"
-                "\"root\":{"
-                    "\"list_param\":\"preset\","
-                    "\"count_param\":\"preset_count\","
-                    "\"name_param\":\"preset_name\","
-                    "\"children\":null,"
-                    "\"knobs\":[\"engine\",\"timbre\",\"color\",\"attack\",\"decay\",\"sustain\",\"cutoff\",\"filt_env\"],"
-                    "\"params\":["
-                        "{\"level\":\"oscillator\",\"label\":\"Oscillator\"},"
-                        "{\"level\":\"envelope\",\"label\":\"Amp Envelope\"},"
-                        "{\"level\":\"filter\",\"label\":\"Filter\"},"
-                        "{\"level\":\"global\",\"label\":\"Global\"}"
-                    "]"
-                "},"
-                "\"oscillator\":{"
-                    "\"children\":null,"
-                    "\"knobs\":[\"engine\",\"timbre\",\"color\",\"fm\"],"
-                    "\"params\":[\"engine\",\"timbre\",\"color\",\"fm\"]"
-                "},"
-                "\"envelope\":{"
-                    "\"children\":null,"
-                    "\"knobs\":[\"attack\",\"decay\",\"sustain\",\"release\"],"
-                    "\"params\":[\"attack\",\"decay\",\"sustain\",\"release\"]"
-                "},"
-                "\"filter\":{"
-                    "\"children\":null,"
-                    "\"knobs\":[\"cutoff\",\"resonance\",\"filt_env\",\"f_attack\",\"f_decay\",\"f_sustain\",\"f_release\"],"
-                    "\"params\":[\"cutoff\",\"resonance\",\"filt_env\",\"f_attack\",\"f_decay\",\"f_sustain\",\"f_release\"]"
-                "},"
-                "\"global\":{"
-                    "\"children\":null,"
-                    "\"knobs\":[\"volume\",\"octave_transpose\"],"
-                    "\"params\":[\"volume\",\"octave_transpose\"]"
-                "}"
-            "}"
-        "}";
-        int len = strlen(hierarchy);
-        if (len < buf_len) {
-            strcpy(buf, hierarchy);
-            return len;
+    if (!inst || !key) return -1;
+    take_midi_params(inst);
+
+    int id = param_hash_find(&g_key_hash, key);
+    switch (id) {
+        case KEY_NAME:
+            return snprintf(buf, buf_len, "Braids");
+        case KEY_OCTAVE_TRANSPOSE:
+            return snprintf(buf, buf_len, "%d", (int)inst->settings[SETTING_OCTAVE_TRANSPOSE]);
+
+        /* Preset browser */
+        case KEY_PRESET:
+            return snprintf(buf, buf_len, "%d", inst->current_preset);
+        case KEY_PRESET_COUNT:
+            return snprintf(buf, buf_len, "%d", preset_count(inst));
+        case KEY_PRESET_NAME:
+            return snprintf(buf, buf_len, "%s", inst->preset_name);
+
+        /* Engine: return name string for enum display */
+        case KEY_ENGINE:
+        case KEY_ENGINE_NAME:
+            return snprintf(buf, buf_len, "%s",
+                            g_shape_names[clamp_shape(inst->params[PARAM_ENGINE])]);
+
+        /* UI hierarchy for shadow parameter editor */
+        case KEY_UI_HIERARCHY:
+            return copy_cached(buf, buf_len, g_ui_hierarchy, (int)sizeof(g_ui_hierarchy) - 1);
+
+        /* State serialization for patch save/load; rebuilt only after a change */
+        case KEY_STATE:
+            if (inst->state_gen != inst->param_gen) {
+                inst->state_len = build_state_json(inst, inst->state_cache,
+                                                   sizeof(inst->state_cache));
+                inst->state_gen = inst->param_gen;
+            }
+            return copy_cached(buf, buf_len, inst->state_cache, inst->state_len);
+
+        case KEY_RENDER_MODE:
+            return snprintf(buf, buf_len, "%s",
+                            inst->settings[SETTING_RENDER_MODE] == RENDER_MODE_SCALAR
+                                ? "scalar" : "lanes");
+        case KEY_FILTER_RATE:
+            return snprintf(buf, buf_len, "%d", (int)inst->settings[SETTING_FILTER_PERIOD]);
+        case KEY_OSC_BLOCK:
+            return snprintf(buf, buf_len, "%d", (int)inst->settings[SETTING_OSC_BLOCK]);
+        case KEY_LATENCY: {
+            /* Frames; the lanes path renders ahead, pipelining (with workers) adds a block */
+            int latency = inst->settings[SETTING_RENDER_MODE] == RENDER_MODE_LANES
+                ? osc_fifo_latency((int)inst->settings[SETTING_OSC_BLOCK]) : 0;
+            if (inst->threading == THREADING_PIPELINED && inst->pool) {
+                latency += MOVE_FRAMES_PER_BLOCK;
+            }
+            return snprintf(buf, buf_len, "%d", latency);
         }
-        return -1;
+        case KEY_MAX_VOICES:
+            return snprintf(buf, buf_len, "%d", (int)inst->settings[SETTING_MAX_VOICES]);
+        case KEY_VOICE_BUDGET:
+            return snprintf(buf, buf_len, "%.1f", inst->settings[SETTING_VOICE_BUDGET]);
+        case KEY_VOICE_LIMIT:
+            return snprintf(buf, buf_len, "%d",
+                            __atomic_load_n(&inst->vm.limit, __ATOMIC_RELAXED));
+        case KEY_STATE_ARENA:
+            return snprintf(buf, buf_len, "%d", (int)inst->settings[SETTING_STATE_ARENA]);
+        case KEY_THREADING:
+            return snprintf(buf, buf_len, "%s", g_threading_names[inst->threading]);
+        case KEY_WORKER_THREADS:
+            return snprintf(buf, buf_len, "%d", inst->pool ? inst->pool->thread_count : 0);
+        case KEY_MIDI_TIMING:
+            return snprintf(buf, buf_len, "%s", g_midi_timing_names[inst->midi_timing]);
+        case KEY_CLIP:
+            return snprintf(buf, buf_len, "%s", g_clip_names[(int)inst->settings[SETTING_CLIP]]);
+        case KEY_SILENCE_THRESHOLD:
+            if (inst->settings[SETTING_SILENCE_LEVEL] <= 0.0f) return snprintf(buf, buf_len, "off");
+            return snprintf(buf, buf_len, "%.1f", inst->silence_db);
+        case KEY_QUALITY:
+            return snprintf(buf, buf_len, "%s", g_quality_names[inst->quality]);
+        case KEY_QUALITY_BUDGET:
+            return snprintf(buf, buf_len, "%.1f", inst->settings[SETTING_QUALITY_BUDGET]);
+        case KEY_QUALITY_ACTIVE:
+            return snprintf(buf, buf_len, "%s",
+                            g_quality_names[__atomic_load_n(&inst->quality_active,
+                                                            __ATOMIC_RELAXED)]);
+
+        /* Memory layout diagnostics, in bytes */
+        case KEY_MEMORY: {
+            int len = snprintf(buf, buf_len,
+                "{\"instance\":%zu,\"voice\":%zu,\"oscillator\":%zu,"
+                "\"delay_lines_max\":%zu,\"arena_stride\":%zu,\"arena_used\":%zu,"
+                "\"arena_reserved\":%zu}",
+                sizeof(braids_instance_t), sizeof(BraidsVoice), sizeof(braids::MacroOscillator),
+                sizeof(braids::DigitalOscillatorDelayLines), inst->arena_stride[inst->engine_side],
+                (inst->arena_stride[0] + inst->arena_stride[1]) * MAX_VOICES,
+                STATE_ARENA_SIDE * 2);
+            return len < buf_len ? len : -1;
+        }
+
+        /* DSP load statistics */
+        case KEY_PERF_STATS:
+            return perf_stats_json(inst, buf, buf_len);
+        case KEY_LOG:
+            return log_poll(buf, buf_len);
+        case KEY_RT_WATCHDOG:
+            return rt_watchdog_json(buf, buf_len);
+#if BRAIDS_PERF_STATS
+        case KEY_PERF_BUDGET:
+            return snprintf(buf, buf_len, "%.1f", inst->perf_budget_pct);
+#endif
+
+        /* Chain params metadata */
+        case KEY_CHAIN_PARAMS:
+            return copy_cached(buf, buf_len, g_chain_params, g_chain_params_len);
+
+        default:
+            break;
     }
 
-    /* State serialization for patch save/load */
-    if (strcmp(key, "state") == 0) {
-        int offset = 0;
-        offset += snprintf(buf + offset, buf_len - offset,
-            "{\"preset\":%d,\"octave_transpose\":%d", inst->current_preset, inst->octave_transpose);
-        for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params); i++) {
-            float val = inst->params[g_shadow_params[i].index];
-            if (g_shadow_params[i].type == PARAM_TYPE_INT) {
-                offset += snprintf(buf + offset, buf_len - offset,
-                    ",\"%s\":%d", g_shadow_params[i].key, (int)val);
-            } else {
-                offset += snprintf(buf + offset, buf_len - offset,
-                    ",\"%s\":%.4f", g_shadow_params[i].key, val);
-            }
+    /* Named parameter access */
+    if (id >= KEY_SHADOW_BASE) {
+        const param_def_t *def = &g_shadow_params[id - KEY_SHADOW_BASE];
+        if (def->type == PARAM_TYPE_INT) {
+            return snprintf(buf, buf_len, "%d", (int)inst->params[def->index]);
         }
-        offset += snprintf(buf + offset, buf_len - offset, "}");
-        return offset;
+        return snprintf(buf, buf_len, "%.3f", inst->params[def->index]);
     }
+    return -1;
+}
 
-    /* Chain params metadata */
-    if (strcmp(key, "chain_params") == 0) {
-        int offset = 0;
-        offset += snprintf(buf + offset, buf_len - offset, "[");
+/* =====================================================================
+ * Audio thread parameter state
+ * ===================================================================== */
 
-        /* Engine as enum with all algorithm names */
-        offset += snprintf(buf + offset, buf_len - offset,
-            "{\"key\":\"engine\",\"name\":\"Algorithm\",\"type\":\"enum\",\"options\":[");
-        for (int i = 0; i < NUM_SHAPES && offset < buf_len - 50; i++) {
-            if (i > 0) offset += snprintf(buf + offset, buf_len - offset, ",");
-            /* Write JSON-escaped string (backslash needs escaping) */
-            buf[offset++] = '"';
-            for (const char *p = g_shape_names[i]; *p && offset < buf_len - 10; p++) {
-                if (*p == '\\' || *p == '"') buf[offset++] = '\\';
-                buf[offset++] = *p;
+static void reset_voices(braids_instance_t *inst) {
+    for (int i = 0; i < MAX_VOICES; i++) {
+        inst->voices[i].active = 0;
+        inst->voices[i].gate = 0;
+        inst->voices[i].amp_env.init();
+        inst->voices[i].filt_env.init();
+    }
+    inst->smooth_snap = 1;  /* New patch: no glide from the old one */
+}
+
+/* Apply everything the control thread queued since the last block */
+static void drain_param_queue(braids_instance_t *inst) {
+    param_msg_t m;
+    while (param_queue_pop(&inst->param_queue, &m)) {
+        if (m.type == PARAM_MSG_RESET_VOICES) {
+            reset_voices(inst);
+        } else if (m.type == PARAM_MSG_SETTING) {
+            if (m.index >= 0 && m.index < SETTING_COUNT) apply_setting(inst, m.index, m.value);
+        } else if (m.index >= 0 && m.index < PARAM_COUNT
+                   && inst->dsp_params[m.index] != m.value) {
+            inst->dsp_params[m.index] = m.value;
+            inst->dsp_dirty |= PARAM_BIT(m.index);
+        }
+    }
+
+    /* Overflow fallback: messages were dropped, take the control state whole */
+    int resync = __atomic_exchange_n(&inst->param_resync, 0, __ATOMIC_ACQUIRE);
+    if (resync & PARAM_RESYNC_VOICES) reset_voices(inst);
+    if (resync & PARAM_RESYNC_PARAMS) {
+        for (int i = 0; i < PARAM_COUNT; i++) {
+            float value = inst->params[i];
+            if (inst->dsp_params[i] == value) continue;
+            inst->dsp_params[i] = value;
+            inst->dsp_dirty |= PARAM_BIT(i);
+        }
+    }
+    if (resync & PARAM_RESYNC_SETTINGS) {
+        for (int i = 0; i < SETTING_COUNT; i++) apply_setting(inst, i, inst->settings[i]);
+    }
+}
+
+/* Per-sample ramps of the smoothed params for the coming chunk */
+static void smooth_params_block(braids_instance_t *inst, int frames) {
+    for (int k = 0; k < SMOOTH_COUNT; k++) {
+        float target = inst->dsp_params[g_smoothed_params[k]];
+        float y = inst->smooth_snap ? target : inst->smooth_state[k];
+        float *ramp = inst->smooth_ramp[k];
+        if (fabsf(target - y) < 1e-5f) {
+            y = target;
+            for (int s = 0; s < frames; s++) ramp[s] = y;
+        } else {
+            for (int s = 0; s < frames; s++) {
+                y += (target - y) * inst->smooth_coef;
+                ramp[s] = y;
             }
-            buf[offset++] = '"';
-            buf[offset] = '\0';
-        }
-        offset += snprintf(buf + offset, buf_len - offset, "]}");
-
-        /* Remaining params */
-        for (int i = 0; i < (int)PARAM_DEF_COUNT(g_shadow_params) && offset < buf_len - 100; i++) {
-            if (strcmp(g_shadow_params[i].key, "engine") == 0) continue;  /* Already handled */
-            /* Float params with 0-1 range get percentage display */
-            int is_pct = (g_shadow_params[i].type == PARAM_TYPE_FLOAT &&
-                          g_shadow_params[i].min_val == 0.0f &&
-                          g_shadow_params[i].max_val == 1.0f);
-            offset += snprintf(buf + offset, buf_len - offset,
-                ",{\"key\":\"%s\",\"name\":\"%s\",\"type\":\"%s\",\"min\":%g,\"max\":%g%s}",
-                g_shadow_params[i].key,
-                g_shadow_params[i].name[0] ? g_shadow_params[i].name : g_shadow_params[i].key,
-                g_shadow_params[i].type == PARAM_TYPE_INT ? "int" : "float",
-                g_shadow_params[i].min_val,
-                g_shadow_params[i].max_val,
-                is_pct ? ",\"unit\":\"%\",\"display_format\":\"%.0f\"" : "");
         }
+        inst->smooth_state[k] = y;
+    }
+    inst->smooth_snap = 0;
+}
 
-        /* Octave transpose */
-        offset += snprintf(buf + offset, buf_len - offset,
-            ",{\"key\":\"octave_transpose\",\"name\":\"Octave\",\"type\":\"int\",\"min\":-3,\"max\":3}");
+/* Timbre / color as smoothed at sample s of the current chunk */
+static inline void set_osc_params_at(braids_instance_t *inst, BraidsVoice *v, int s) {
+    int16_t timbre = (int16_t)(inst->smooth_ramp[SMOOTH_TIMBRE][s] * 32767.0f);
+    int16_t color = (int16_t)(inst->smooth_ramp[SMOOTH_COLOR][s] * 32767.0f);
+    v->osc[v->side].set_parameters(timbre, color);
+    if (v->fade_pos < ENGINE_FADE_SAMPLES) v->osc[v->side ^ 1].set_parameters(timbre, color);
+}
+
+static_assert(OSC_BLOCK_MAX <= braids::kMaxBlockSize, "oscillator block too large");
+
+static inline int16_t clamp_pitch(int32_t pitch) {
+    if (pitch < 0) return 0;
+    if (pitch > 32767) return 32767;
+    return (int16_t)pitch;
+}
+
+/* Set up a voice's pitch for the coming chunk (gliding: per block) */
+static void prepare_voice(BraidsVoice *v, int32_t pitch_offset) {
+    if (v->glide_increment) return;
+    v->pitch = clamp_pitch(note_to_pitch(v->note) + pitch_offset);
+}
 
-        offset += snprintf(buf + offset, buf_len - offset, "]");
-        return offset;
+/*
+ * Portamento: step a gliding voice's pitch along the exponential approach
+ * curve braids::Envelope uses, once per oscillator block. The engines take
+ * their phase increments from the pitch, so a glide is a pitch ramp and each
+ * block's increments are refreshed from it (only while the pitch moves).
+ */
+static void glide_voice(BraidsVoice *v, int32_t pitch_offset, int size) {
+    if (!v->glide_increment) return;
+    int32_t target = note_to_pitch(v->note);
+    int32_t shape = stmlib::Interpolate824(braids::lut_env_expo, v->glide_phase);
+    int32_t pitch = v->glide_from + ((target - v->glide_from) * shape >> 16);
+    v->pitch = clamp_pitch(pitch + pitch_offset);
+
+    uint64_t phase = (uint64_t)v->glide_phase + (uint64_t)v->glide_increment * (uint32_t)size;
+    if (phase > 0xffffffffu) {
+        v->glide_increment = 0;  /* Arrived: from the next chunk, prepare_voice sets the pitch */
+    } else {
+        v->glide_phase = (uint32_t)phase;
     }
+}
 
-    return -1;
+/*
+ * The engines oversampled at high quality: those that alias audibly (FM,
+ * wave folding, ring modulation, wavetables) and whose sound follows from
+ * their phase increments alone, so that an octave down at twice the rate
+ * is the same sound. Engines with decays, filters or delay lines would run
+ * them at twice the speed.
+ */
+static int shape_oversamples(int shape) {
+    switch (shape) {
+        case braids::MACRO_OSC_SHAPE_SINE_TRIANGLE:
+        case braids::MACRO_OSC_SHAPE_TRIPLE_RING_MOD:
+        case braids::MACRO_OSC_SHAPE_FM:
+        case braids::MACRO_OSC_SHAPE_FEEDBACK_FM:
+        case braids::MACRO_OSC_SHAPE_CHAOTIC_FEEDBACK_FM:
+        case braids::MACRO_OSC_SHAPE_WAVETABLES:
+        case braids::MACRO_OSC_SHAPE_WAVE_MAP:
+        case braids::MACRO_OSC_SHAPE_WAVE_LINE:
+            return 1;
+        default:
+            return 0;
+    }
 }
 
-/* v2 API: Render audio */
-static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int frames) {
-    braids_instance_t *inst = (braids_instance_t*)instance;
-    if (!inst) {
-        memset(out_interleaved_lr, 0, frames * 4);
-        return;
+static_assert(OSC_BLOCK_MAX <= HALFBAND_BLOCK_MAX, "oscillator block too large to decimate");
+
+/*
+ * Render size samples of one engine side, unison stack included. Where the
+ * side oversamples, the oscillator renders 2 * size samples an octave down
+ * (in MacroOscillator-sized pieces) and the half-band filter takes them
+ * back to size; hard sync is only ever rendered at the base rate. The
+ * oscillator keeps the pitch it renders at, so its cached increments hold
+ * from block to block at either rate.
+ */
+static void render_engine_side(const RenderFrame *f, BraidsVoice *v, int side,
+                               const uint8_t *sync, int16_t *buffer, int size) {
+    braids::MacroOscillator *osc = &v->osc[side];
+    int16_t pitch = v->pitch;
+    osc->set_reduced_partials(f->quality == QUALITY_ECO);
+    if (f->oversample[side] && !sync && pitch >= QUALITY_OVERSAMPLE_MIN_PITCH) {
+        int16_t wide[2 * OSC_BLOCK_MAX];
+        osc->set_pitch(pitch - (12 << 7));
+        for (int done = 0; done < 2 * size; ) {
+            int n = 2 * size - done;
+            if (n > (int)braids::kMaxBlockSize) n = (int)braids::kMaxBlockSize;
+            osc->Render(NULL, wide + done, n);
+            done += n;
+        }
+        halfband_decimate(&v->halfband[side], wide, buffer, size);
+    } else {
+        osc->set_pitch(pitch);
+        osc->Render(sync, buffer, size);
+        v->halfband[side].live = 0;
+    }
+    if (f->unison[side] > 1) {
+        unison_bank_render(&v->unison[side], f->unison_wave[side], f->unison[side],
+                           pitch, f->unison_spread, buffer, size);
+    }
+}
+
+/*
+ * Render size samples of the voice's engine into buffer; mid-switch,
+ * crossfaded (linearly) from the engine on the other side, which renders
+ * into fade_buffer. sync is NULL until there is a sync source, which
+ * selects the oscillators' renderers without the reset test.
+ */
+static void render_voice_engine(const RenderFrame *f, BraidsVoice *v, const uint8_t *sync,
+                                int16_t *buffer, int size) {
+    render_engine_side(f, v, v->side, sync, buffer, size);
+    if (v->fade_pos >= ENGINE_FADE_SAMPLES) return;
+
+    int16_t *from = v->fade_buffer;
+    render_engine_side(f, v, v->side ^ 1, sync, from, size);
+    int pos = v->fade_pos;
+    for (int s = 0; s < size; s++, pos++) {
+        int32_t w = pos < ENGINE_FADE_SAMPLES ? pos << (15 - ENGINE_FADE_SHIFT) : 32768;
+        buffer[s] = (int16_t)(from[s] + ((buffer[s] - from[s]) * w >> 15));
     }
+    v->fade_pos = pos < ENGINE_FADE_SAMPLES ? pos : ENGINE_FADE_SAMPLES;
+}
 
-    float gain = inst->params[PARAM_VOLUME] / (float)MAX_VOICES;
-    float fm_amount = inst->params[PARAM_FM];
-    float base_cutoff = inst->params[PARAM_CUTOFF];
-    float filt_env_amount = inst->params[PARAM_FILT_ENV];
-    int use_filter = (base_cutoff < 0.99f || inst->params[PARAM_RESONANCE] > 0.01f
-                      || filt_env_amount > 0.01f);
+#if BRAIDS_PERF_STATS
+/* Attribute a voice's render cost to its slot and to the current engine */
+static void perf_record_voice(braids_instance_t *inst, int vi, uint64_t ticks) {
+    int shape = current_shape(inst);
+    inst->perf.voice_last[vi] += ticks;  /* Summed over the block's chunks */
+    inst->perf.voice_ticks[vi] += ticks;
+    inst->perf.voice_blocks[vi]++;
+    inst->perf.engine_ticks[shape] += ticks;
+    inst->perf.engine_blocks[shape]++;
+}
+#endif
 
-    /* Clear output */
-    memset(out_interleaved_lr, 0, frames * 4);
+/*
+ * A chunk is rendered as one job per active voice followed by a mix in
+ * voice order. Jobs only write their own voice, so they may run on any
+ * thread in any order and the result is the same as rendering serially.
+ */
 
-    /* Render each active voice */
+/* Fix the chunk's settings and list its voices. Returns: number of jobs */
+static int render_setup(braids_instance_t *inst, int16_t *out, int frames) {
+    RenderFrame *f = &inst->frame;
+    f->out = out;
+    f->frames = frames;
+    f->mode = inst->render_mode;
+    f->osc_block = inst->osc_block;
+    f->gain_scale = 1.0f / inst->vm.gain_voices;
+    /* FM from the mod wheel, up to 12 semitones, plus pitch bend */
+    float fm_amount = inst->dsp_params[PARAM_FM];
+    f->pitch_offset = inst->pitch_bend;
+    if (fm_amount > 0.001f) f->pitch_offset += (int16_t)(fm_amount * 1536.0f);
+    f->filter.cutoff = inst->smooth_ramp[SMOOTH_CUTOFF];
+    f->filter.env_amount = inst->dsp_params[PARAM_FILT_ENV];
+    f->filter.enabled = (fminf(f->filter.cutoff[0], f->filter.cutoff[frames - 1]) < 0.99f
+                         || inst->dsp_params[PARAM_RESONANCE] > 0.01f
+                         || f->filter.env_amount > 0.01f);
+    f->quality = inst->quality_active;
+    f->filter.control_period = inst->filter_period;
+    if (f->quality == QUALITY_ECO && f->filter.control_period < QUALITY_ECO_FILTER_PERIOD) {
+        f->filter.control_period = QUALITY_ECO_FILTER_PERIOD;
+    }
+    f->damp = inst->svf_damp;  /* Resonance is shared by all voices */
+    f->clip = inst->clip;
+    int copies = (int)inst->dsp_params[PARAM_UNISON];
+    if (copies < 1) copies = 1;
+    if (copies > UNISON_MAX) copies = UNISON_MAX;
+    for (int side = 0; side < 2; side++) {
+        f->unison_wave[side] = unison_wave(inst->side_shape[side]);
+        f->unison[side] = f->unison_wave[side] != UNISON_WAVE_NONE ? copies : 1;
+        f->oversample[side] = f->quality == QUALITY_HIGH
+                              && shape_oversamples(inst->side_shape[side]);
+    }
+    f->unison_spread = (int32_t)(inst->dsp_params[PARAM_UNISON_SPREAD] * UNISON_DETUNE_MAX);
+
+    int count = 0;
     for (int vi = 0; vi < MAX_VOICES; vi++) {
-        BraidsVoice *v = &inst->voices[vi];
-        if (!v->active) continue;
+        if (inst->voices[vi].active) inst->job_voices[count++] = (uint8_t)vi;
+    }
+    inst->job_count = count;
+    return count;
+}
 
-        /* Update oscillator parameters */
-        apply_params_to_voice(inst, v);
+/*
+ * Reference path job: the voice runs its envelopes, SVF and gain per sample
+ * into voice_mix (volume is applied with the mix), zero-padded if it
+ * finishes early.
+ */
+static void render_voice_scalar(braids_instance_t *inst, BraidsVoice *v) {
+    const RenderFrame *f = &inst->frame;
+    const float *base_cutoff = f->filter.cutoff;
+    int frames = f->frames;
+
+    prepare_voice(v, f->pitch_offset);
+
+    /* Render in 24-sample blocks */
+    int rendered = 0;
+    while (rendered < frames) {
+        int block_size = BRAIDS_BLOCK_SIZE;
+        if (rendered + block_size > frames) {
+            block_size = frames - rendered;
+        }
 
-        /* Apply FM from mod wheel to pitch */
-        int16_t pitch = note_to_pitch(v->note);
-        if (fm_amount > 0.001f) {
-            pitch += (int16_t)(fm_amount * 1536.0f); /* Up to 12 semitones */
+        /*
+         * Render oscillator. Several digital engines render sample pairs,
+         * so it always runs for an even count; a spare sample waits in the
+         * FIFO (which may also hold samples from the lanes path).
+         */
+        int have = v->fifo_count < block_size ? v->fifo_count : block_size;
+        memcpy(v->osc_buffer, v->osc_fifo, have * sizeof(int16_t));
+        v->fifo_count -= have;
+        memmove(v->osc_fifo, v->osc_fifo + have, v->fifo_count * sizeof(int16_t));
+        int need = block_size - have;
+        if (need > 0) {
+            int count = (need + 1) & ~1;
+            set_osc_params_at(inst, v, rendered);
+            glide_voice(v, f->pitch_offset, count);
+            render_voice_engine(f, v, NULL, v->osc_buffer + have, count);
+            if (count > need) v->osc_fifo[v->fifo_count++] = v->osc_buffer[block_size];
         }
-        v->osc.set_pitch(pitch);
 
-        /* Render in 24-sample blocks */
-        int rendered = 0;
-        while (rendered < frames) {
-            int block_size = BRAIDS_BLOCK_SIZE;
-            if (rendered + block_size > frames) {
-                block_size = frames - rendered;
+        /* Envelope segments for the block; the voice ends where amp goes idle */
+        float amp_level[BRAIDS_BLOCK_SIZE];
+        float filt_level[BRAIDS_BLOCK_SIZE];
+        int idle_at = v->amp_env.render(amp_level, block_size);
+        v->filt_env.render(filt_level, block_size);
+        int end = v->gate ? block_size : idle_at;
+
+        /* Apply envelope and gain */
+        for (int s = 0; s < end; s++) {
+            /* Apply amplitude envelope to oscillator output */
+            int32_t sample = v->osc_buffer[s];
+            sample = (int32_t)(sample * amp_level[s]);
+
+            /* Apply SVF filter with envelope modulation */
+            if (f->filter.enabled) {
+                float mod_cutoff = base_cutoff[rendered + s] + filt_level[s] * f->filter.env_amount;
+                if (mod_cutoff > 1.0f) mod_cutoff = 1.0f;
+                int16_t cutoff_freq = (int16_t)(mod_cutoff * 127.0f) << 7;
+                v->svf.set_frequency(cutoff_freq);
+                sample = v->svf.Process(sample);
             }
 
-            /* Render oscillator */
-            memset(v->sync_buffer, 0, sizeof(v->sync_buffer));
-            v->osc.Render(v->sync_buffer, v->osc_buffer, block_size);
+            /* Velocity scaling */
+            sample = (sample * v->velocity) / 127;
 
-            /* Apply envelope and mix to output */
-            for (int s = 0; s < block_size; s++) {
-                /* Process ADSR envelopes */
-                float amp = v->amp_env.process();
-                float filt_val = v->filt_env.process();
+            v->voice_mix[rendered + s] = (float)sample * f->gain_scale;
+        }
 
-                /* Check if amplitude envelope has finished */
-                if (!v->gate && !v->amp_env.is_active()) {
-                    v->active = 0;
-                    break;
-                }
+        if (end < block_size) {
+            v->active = 0;
+            memset(v->voice_mix + rendered + end, 0, (frames - rendered - end) * sizeof(float));
+            break;
+        }
+        rendered += block_size;
+    }
+}
 
-                /* Apply amplitude envelope to oscillator output */
-                int32_t sample = v->osc_buffer[s];
-                sample = (int32_t)(sample * amp);
-
-                /* Apply SVF filter with envelope modulation */
-                if (use_filter) {
-                    float mod_cutoff = base_cutoff + filt_val * filt_env_amount;
-                    if (mod_cutoff > 1.0f) mod_cutoff = 1.0f;
-                    int16_t cutoff_freq = (int16_t)(mod_cutoff * 127.0f) << 7;
-                    v->svf.set_frequency(cutoff_freq);
-                    sample = v->svf.Process(sample);
-                }
+/* Lanes path job: fixed osc_block-sized oscillator blocks through the FIFO */
+static void render_voice_osc(braids_instance_t *inst, BraidsVoice *v) {
+    const RenderFrame *f = &inst->frame;
+    int frames = f->frames;
+    int osc_block = f->osc_block;
+
+    prepare_voice(v, f->pitch_offset);
+
+    /* Drain the FIFO, then render whole oscillator blocks */
+    int filled = v->fifo_count;
+    memcpy(v->osc_out, v->osc_fifo, filled * sizeof(int16_t));
+    while (filled < frames) {
+        set_osc_params_at(inst, v, filled);
+        glide_voice(v, f->pitch_offset, osc_block);
+        render_voice_engine(f, v, NULL, v->osc_out + filled, osc_block);
+        filled += osc_block;
+    }
+    v->fifo_count = filled - frames;
+    memcpy(v->osc_fifo, v->osc_out + frames, v->fifo_count * sizeof(int16_t));
+
+    /* The filter envelope runs with the filter off too (no jump when it is
+     * switched back on) */
+    v->idle_at = v->amp_env.render(v->amp_level, frames);
+    v->filt_env.render(v->filt_level, frames);
+}
+
+/* worker_job_fn: render voice job_voices[index] */
+static void render_voice_job(void *ctx, int index) {
+    braids_instance_t *inst = (braids_instance_t*)ctx;
+    BraidsVoice *v = &inst->voices[inst->job_voices[index]];
+    RT_WATCH_SCOPE();  /* On a worker, or nested in render_block's */
+    PERF_BEGIN(voice_start);
+    /* Random's state is per thread; a per-voice stream keeps the noise
+     * engines identical whichever thread renders the voice */
+    stmlib::Random::Seed(v->rng_state);
+    if (inst->frame.mode == RENDER_MODE_SCALAR) {
+        render_voice_scalar(inst, v);
+    } else {
+        render_voice_osc(inst, v);
+    }
+    v->rng_state = stmlib::Random::state();
+    PERF_END(voice_start, voice_ticks);
+#if BRAIDS_PERF_STATS
+    v->job_ticks = voice_ticks;
+#endif
+}
+
+/* Engines whose sound dies away after the strike even while the key is held */
+static int shape_decays(int shape) {
+    switch (shape) {
+        case braids::MACRO_OSC_SHAPE_PLUCKED:
+        case braids::MACRO_OSC_SHAPE_STRUCK_BELL:
+        case braids::MACRO_OSC_SHAPE_STRUCK_DRUM:
+        case braids::MACRO_OSC_SHAPE_KICK:
+        case braids::MACRO_OSC_SHAPE_SNARE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Silence detection, run by the mix: peak is the voice's largest |output|
+ * over the chunk's frames, in int16 units before volume. A voice that has
+ * been quiet for SILENCE_HOLD samples stops here rather than rendering the
+ * rest of a long release (or a held bell) below audibility; its envelopes
+ * are cleared so that the next note on the slot attacks from 0.
+ */
+static void voice_track_silence(braids_instance_t *inst, BraidsVoice *v, float peak,
+                                int frames) {
+    if (!v->active) return;
+    if (peak >= inst->silence_level) {
+        v->quiet = 0;
+        return;
+    }
+    if (v->quiet < SILENCE_HOLD) v->quiet += frames;
+    if (v->quiet < SILENCE_HOLD) return;
+    if (v->gate && (!shape_decays(inst->side_shape[v->side])
+                    || v->amp_env.stage == SimpleADSR::ATTACK)) {
+        return;
+    }
+    v->active = 0;
+    v->amp_env.init();
+    v->filt_env.init();
+#if BRAIDS_PERF_STATS
+    inst->perf.silence_retired++;
+#endif
+}
 
-                /* Velocity scaling */
-                sample = (sample * v->velocity) / 127;
+/* Scalar path mix: sum the voices on the bus in voice order, then output */
+static void mix_voices_scalar(braids_instance_t *inst) {
+    const RenderFrame *f = &inst->frame;
+    float *bus = inst->mix_bus;
+    memset(bus, 0, f->frames * sizeof(float));
+    for (int i = 0; i < inst->job_count; i++) {
+        BraidsVoice *v = &inst->voices[inst->job_voices[i]];
+        const float *mix = v->voice_mix;
+        float peak = 0.0f;
+        for (int s = 0; s < f->frames; s++) {
+            float m = fabsf(mix[s]);
+            peak = m > peak ? m : peak;
+            bus[s] += mix[s];
+        }
+        voice_track_silence(inst, v, peak, f->frames);
+    }
+    voice_lanes_output(bus, inst->smooth_ramp[SMOOTH_VOLUME], f->clip, f->out, f->frames);
+}
 
-                /* Mix to stereo output (accumulate) */
-                int idx = (rendered + s) * 2;
-                int32_t left = out_interleaved_lr[idx] + (int32_t)(sample * gain);
-                int32_t right = out_interleaved_lr[idx + 1] + (int32_t)(sample * gain);
+/*
+ * Lanes path mix: envelope levels, SVF and gain for all voices at once,
+ * one lane per voice, into the bus; then volume and a single saturation.
+ * Each lane's output peak feeds silence detection.
+ */
+static void mix_voices_lanes(braids_instance_t *inst) {
+    static const int16_t silence[MOVE_FRAMES_PER_BLOCK] = {0};
+    static const float idle[MOVE_FRAMES_PER_BLOCK] = {0};
+    const RenderFrame *f = &inst->frame;
+    int frames = f->frames;
+
+    float *mix = inst->mix_bus;
+    memset(mix, 0, frames * sizeof(float));
+
+    for (int gi = 0; gi < VOICE_LANE_GROUPS; gi++) {
+        voice_lane_group_t group;
+        const int16_t *in[VOICE_LANE_WIDTH];
+        memset(&group, 0, sizeof(group));
+
+        for (int i = 0; i < VOICE_LANE_WIDTH; i++) {
+            int vi = gi * VOICE_LANE_WIDTH + i;
+            in[i] = silence;
+            group.amp[i] = idle;
+            group.filt[i] = idle;
+            if (vi >= MAX_VOICES || !inst->voices[vi].active) continue;
+
+            BraidsVoice *v = &inst->voices[vi];
+            in[i] = v->osc_out;
+            group.amp[i] = v->amp_level;
+            group.filt[i] = v->filt_level;
+            group.idle_at[i] = v->idle_at;
+            group.lp[i] = v->svf.lp();
+            group.bp[i] = v->svf.bp();
+            group.damp[i] = f->damp;
+            group.frequency[i] = v->svf.frequency();
+            group.f[i] = stmlib::Interpolate824(braids::lut_svf_cutoff,
+                                                (uint32_t)group.frequency[i] << 17);
+            group.gain[i] = f->gain_scale * (float)v->velocity / 127.0f;
+            group.gate[i] = v->gate ? -1 : 0;
+            group.alive[i] = -1;
+        }
+        if (!lane_any(group.alive)) continue;
 
-                if (left > 32767) left = 32767;
-                if (left < -32768) left = -32768;
-                if (right > 32767) right = 32767;
-                if (right < -32768) right = -32768;
+        voice_lanes_render(&group, in, &f->filter, mix, frames);
 
-                out_interleaved_lr[idx] = (int16_t)left;
-                out_interleaved_lr[idx + 1] = (int16_t)right;
-            }
+        for (int i = 0; i < VOICE_LANE_WIDTH; i++) {
+            int vi = gi * VOICE_LANE_WIDTH + i;
+            if (vi >= MAX_VOICES || !inst->voices[vi].active) continue;
 
-            if (!v->active) break;
-            rendered += block_size;
+            BraidsVoice *v = &inst->voices[vi];
+            v->svf.set_state(group.lp[i], group.bp[i]);
+            v->svf.set_frequency((int16_t)group.frequency[i]);
+            if (!group.alive[i]) v->active = 0;
+            voice_track_silence(inst, v, group.peak[i], frames);
         }
     }
+
+    voice_lanes_output(mix, inst->smooth_ramp[SMOOTH_VOLUME], f->clip, f->out, frames);
+}
+
+/* worker_finish_fn: mix the chunk once every voice job is done */
+static void render_mix(void *ctx) {
+    braids_instance_t *inst = (braids_instance_t*)ctx;
+    PERF_BEGIN(post_start);
+    if (inst->frame.mode == RENDER_MODE_SCALAR) {
+        mix_voices_scalar(inst);
+    } else {
+        mix_voices_lanes(inst);
+    }
+    PERF_END(post_start, post_ticks);
+#if BRAIDS_PERF_STATS
+    inst->perf.post_last = post_ticks;
+    inst->perf.post_ticks += post_ticks;
+#endif
+}
+
+/* Feed the finished jobs' costs into perf (render thread, after the mix) */
+static void render_record(braids_instance_t *inst) {
+#if BRAIDS_PERF_STATS
+    for (int i = 0; i < inst->job_count; i++) {
+        int vi = inst->job_voices[i];
+        perf_record_voice(inst, vi, inst->voices[vi].job_ticks);
+    }
+#else
+    (void)inst;
+#endif
+}
+
+/*
+ * Render one chunk (frames <= MOVE_FRAMES_PER_BLOCK) into out. With a pool
+ * and at least two voices the jobs are spread over the workers, the calling
+ * thread helping; one voice (or a pool busy with another instance) renders
+ * inline. async leaves a pool batch running, with the mix done by whichever
+ * thread finishes last, until pipeline_wait. Returns: 1 if still running.
+ */
+static int render_voices(braids_instance_t *inst, int16_t *out, int frames,
+                         worker_pool_t *pool, int async) {
+    int count = render_setup(inst, out, frames);
+    if (count == 0) return 0;
+
+    uint32_t ticket;
+    if (count > 1 && worker_pool_submit(pool, render_voice_job, async ? render_mix : NULL,
+                                        inst, count, &ticket) == 0) {
+        if (async) {
+            inst->pipeline_ticket = ticket;
+            inst->pipeline_inflight = 1;
+            return 1;
+        }
+        worker_pool_wait(pool, ticket);
+    } else {
+        for (int i = 0; i < count; i++) render_voice_job(inst, i);
+    }
+    render_mix(inst);
+    render_record(inst);
+    return 0;
+}
+
+/* Wait for a pipelined batch still rendering, if any */
+static void pipeline_wait(braids_instance_t *inst) {
+    if (!inst->pipeline_inflight) return;
+    worker_pool_wait(inst->pool, inst->pipeline_ticket);
+    inst->pipeline_inflight = 0;
+}
+
+/*
+ * Give each queued MIDI event its frame in the coming block: block timing
+ * (and messages held back by pipelining) at 0, spread evenly in arrival
+ * order, or clock at the fraction of the block that its arrival was of the
+ * time since the previous render_block. Frames never go backwards.
+ */
+static void place_midi_events(braids_instance_t *inst, int timing, int frames, uint64_t now) {
+    uint64_t start = inst->midi_block_time;
+    uint64_t elapsed = now - start;
+    int count = inst->midi_event_count;
+    int last = 0;
+    for (int i = 0; i < count; i++) {
+        MidiEvent *e = &inst->midi_events[i];
+        int frame = 0;
+        if (timing == MIDI_TIMING_SPREAD) {
+            frame = i * frames / count;
+        } else if (timing == MIDI_TIMING_CLOCK && start && elapsed && e->time > start) {
+            frame = (int)((e->time - start) * (uint64_t)frames / elapsed);
+        }
+        if (frame >= frames) frame = frames - 1;
+        if (frame < last) frame = last;
+        e->frame = last = frame;
+    }
+    inst->midi_block_time = now;
+}
+
+/* v2 API: Render audio */
+static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int frames) {
+    braids_instance_t *inst = (braids_instance_t*)instance;
+    if (!inst) {
+        memset(out_interleaved_lr, 0, frames * 4);
+        return;
+    }
+    RT_WATCH_SCOPE();
+
+    int threading = __atomic_load_n(&inst->threading, __ATOMIC_ACQUIRE);
+    worker_pool_t *pool = threading != THREADING_OFF
+        ? __atomic_load_n(&inst->pool, __ATOMIC_ACQUIRE) : NULL;
+    int timing = __atomic_load_n(&inst->midi_timing, __ATOMIC_RELAXED);
+
+    PERF_BEGIN(block_start);
+    uint64_t vm_start = perf_now();
+
+    /* Last block's pipelined batch has had a whole block period to finish */
+    pipeline_wait(inst);
+#if BRAIDS_PERF_STATS
+    if (inst->perf_reset_pending) {
+        memset(&inst->perf, 0, sizeof(inst->perf));
+        inst->perf_reset_pending = 0;
+    }
+    memset(inst->perf.voice_last, 0, sizeof(inst->perf.voice_last));
+    inst->perf.post_last = 0;
+#endif
+    if (inst->pipeline_unrecorded) {
+        render_record(inst);
+        inst->pipeline_unrecorded = 0;
+    }
+
+    /* Events due at frame 0 go before the block's parameter update, as untimed MIDI does */
+    place_midi_events(inst, timing, frames, vm_start);
+    int ev = 0;
+    for (; ev < inst->midi_event_count && inst->midi_events[ev].frame == 0; ev++) {
+        handle_midi(inst, inst->midi_events[ev].msg, inst->midi_events[ev].len);
+    }
+
+    drain_param_queue(inst);
+    uint32_t dirty = update_param_caches(inst);
+    if (dirty) {
+        for (int i = 0; i < MAX_VOICES; i++) {
+            if (inst->voices[i].active) update_voice_params(inst, &inst->voices[i], dirty);
+        }
+    }
+    carve_state_arena(inst);
+    engine_switch_update(inst);
+    enforce_voice_limit(inst);
+    int sounding = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (inst->voices[i].active) sounding++;
+    }
+
+    /* Without workers (a single core) pipelining would only add latency */
+    int pipelined = threading == THREADING_PIPELINED && pool
+                    && frames == MOVE_FRAMES_PER_BLOCK;
+
+    /*
+     * Hand out what was rendered ahead first: all of the last block while
+     * pipelined, or what is left of it after a short block or a switch out
+     * of the mode, which then renders only the rest of this call
+     */
+    int handed = inst->pipeline_pending < frames ? inst->pipeline_pending : frames;
+    memcpy(out_interleaved_lr, inst->pipeline_out + inst->pipeline_read * 2, handed * 4);
+    inst->pipeline_pending -= handed;
+    inst->pipeline_read += handed;
+
+    int16_t *target = out_interleaved_lr;
+    int start = handed;
+    if (pipelined) {
+        /* Start on this block; short of a whole one, the rest goes out silent */
+        memset(out_interleaved_lr + handed * 2, 0, (frames - handed) * 4);
+        target = inst->pipeline_out;
+        start = 0;
+        inst->pipeline_pending = frames;
+        inst->pipeline_read = 0;
+    }
+
+    /* Clear output */
+    memset(target + start * 2, 0, (frames - start) * 4);
+
+    /*
+     * Render in chunks of at most one host block, cut short at the next
+     * timed event so that it strikes or releases on its own sample. Only
+     * the last chunk of a pipelined block is left running.
+     */
+    for (int offset = start; offset < frames; ) {
+        for (; ev < inst->midi_event_count && inst->midi_events[ev].frame <= offset; ev++) {
+            handle_midi(inst, inst->midi_events[ev].msg, inst->midi_events[ev].len);
+        }
+        int end = offset + MOVE_FRAMES_PER_BLOCK;
+        if (end > frames) end = frames;
+        if (ev < inst->midi_event_count && inst->midi_events[ev].frame < end) {
+            end = inst->midi_events[ev].frame;
+        }
+        int async = pipelined && end == frames;
+        smooth_params_block(inst, end - offset);
+        int running = render_voices(inst, target + offset * 2, end - offset, pool, async);
+        if (async) inst->pipeline_unrecorded = running;
+        offset = end;
+    }
+    /* Events still due when the rendered-ahead audio filled the whole call */
+    for (; ev < inst->midi_event_count; ev++) {
+        handle_midi(inst, inst->midi_events[ev].msg, inst->midi_events[ev].len);
+    }
+    inst->midi_event_count = 0;
+
+    uint64_t vm_ticks = perf_now() - vm_start;
+    voice_manager_update(inst, vm_ticks, sounding, frames - start);
+    quality_update(inst, vm_ticks, frames - start);
+
+    PERF_END(block_start, block_ticks);
+#if BRAIDS_PERF_STATS
+    uint64_t realtime_ticks = (uint64_t)frames * g_perf_ticks_per_sec / MOVE_SAMPLE_RATE;
+    perf_block_record(&inst->perf.block, block_ticks, realtime_ticks,
+                      (uint64_t)(realtime_ticks * inst->perf_budget_pct / 100.0f));
+#endif
 }
 
 /* No external assets required */
@@ -1003,6 +3136,16 @@ static plugin_api_v2_t g_plugin_api_v2;
 
 extern "C" plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host) {
     g_host = host;
+    g_perf_ticks_per_sec = perf_ticks_per_sec();
+    g_chain_params_len = build_chain_params_json(g_chain_params, sizeof(g_chain_params));
+    if (build_key_hashes() != 0) plugin_log("parameter key hash build failed");
+
+    if (host && host->sample_rate && (uint32_t)host->sample_rate != braids::kSampleRate) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "tables built for %u Hz, host runs at %d Hz",
+                 (unsigned)braids::kSampleRate, host->sample_rate);
+        plugin_log(msg);
+    }
 
     memset(&g_plugin_api_v2, 0, sizeof(g_plugin_api_v2));
     g_plugin_api_v2.api_version = MOVE_PLUGIN_API_VERSION_2;
@@ -1014,5 +3157,6 @@ extern "C" plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host) {
     g_plugin_api_v2.get_error = v2_get_error;
     g_plugin_api_v2.render_block = v2_render_block;
 
+    log_flush();
     return &g_plugin_api_v2;
 }
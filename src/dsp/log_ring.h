@@ -0,0 +1,132 @@
+/*
+ * log_ring.h - Lock-free log line ring for real-time threads
+ *
+ * Multi-producer / single-consumer ring of fixed-size text lines. Any thread,
+ * the audio thread included, may push: a push claims a slot with one
+ * compare-and-swap, formats into it and publishes it, with no lock, no
+ * allocation and no system call. A full ring drops the line and counts it.
+ * One consumer at a time drains the lines from a context that may block
+ * (e.g. to hand them to the host's logger); a second concurrent drain finds
+ * the ring busy and reads nothing.
+ *
+ * Zero-initialised storage is an empty ring, so a static one needs no init.
+ * Each slot's sequence is kept relative to its index (Vyukov's bounded
+ * queue, offset so that 0 means "free for the first lap").
+ *
+ * Usage:
+ *   producer: log_ring_printf(&ring, "voice %d stolen", vi);
+ *   consumer: if (log_ring_begin_drain(&ring)) {
+ *                 while (log_ring_pop(&ring, line, sizeof(line))) emit(line);
+ *                 log_ring_end_drain(&ring);
+ *             }
+ */
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_RING_SIZE 64            /* Lines, power of two */
+#define LOG_RING_LINE 256           /* Bytes per line, NUL included */
+
+typedef struct {
+    uint32_t seq;                   /* Lap marker, relative to the slot index */
+    char text[LOG_RING_LINE];
+} log_ring_slot_t;
+
+typedef struct {
+    log_ring_slot_t slots[LOG_RING_SIZE];
+    uint32_t head;                  /* Next position to claim; producers CAS */
+    uint32_t tail;                  /* Next position to read; drain-owned */
+    uint32_t draining;              /* 1 while a consumer holds the ring */
+    uint32_t dropped;               /* Lines lost to a full ring */
+} log_ring_t;
+
+/* Claim the next free slot. Returns: the slot, NULL if the ring is full */
+static inline log_ring_slot_t *log_ring_claim(log_ring_t *r) {
+    uint32_t pos = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+    for (;;) {
+        uint32_t index = pos & (LOG_RING_SIZE - 1);
+        log_ring_slot_t *slot = &r->slots[index];
+        int32_t lap = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (pos - index));
+        if (lap == 0) {
+            if (__atomic_compare_exchange_n(&r->head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                return slot;
+            }
+        } else if (lap < 0) {
+            __atomic_fetch_add(&r->dropped, 1, __ATOMIC_RELAXED);
+            return NULL;    /* Still holds a line from the last lap */
+        } else {
+            pos = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Hand a claimed slot to the consumer (pos is recovered from seq) */
+static inline void log_ring_publish(log_ring_slot_t *slot) {
+    __atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+}
+
+/* Push one formatted line. Returns: 0, -1 if dropped */
+static inline int log_ring_vprintf(log_ring_t *r, const char *fmt, va_list args) {
+    log_ring_slot_t *slot = log_ring_claim(r);
+    if (!slot) return -1;
+    vsnprintf(slot->text, sizeof(slot->text), fmt, args);
+    log_ring_publish(slot);
+    return 0;
+}
+
+static inline int log_ring_printf(log_ring_t *r, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+static inline int log_ring_printf(log_ring_t *r, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int result = log_ring_vprintf(r, fmt, args);
+    va_end(args);
+    return result;
+}
+
+/* Become the ring's consumer. Returns: 1, 0 if another drain is running */
+static inline int log_ring_begin_drain(log_ring_t *r) {
+    return __atomic_exchange_n(&r->draining, 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+static inline void log_ring_end_drain(log_ring_t *r) {
+    __atomic_store_n(&r->draining, 0, __ATOMIC_RELEASE);
+}
+
+/* Consumer side. Returns: the next line, NULL if none is ready */
+static inline const char *log_ring_peek(log_ring_t *r) {
+    uint32_t index = r->tail & (LOG_RING_SIZE - 1);
+    log_ring_slot_t *slot = &r->slots[index];
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != r->tail - index + 1) return NULL;
+    return slot->text;
+}
+
+/* Consumer side: release the line log_ring_peek returned */
+static inline void log_ring_next(log_ring_t *r) {
+    uint32_t index = r->tail & (LOG_RING_SIZE - 1);
+    /* Free for the producer one lap later */
+    __atomic_store_n(&r->slots[index].seq, r->tail - index + LOG_RING_SIZE, __ATOMIC_RELEASE);
+    r->tail++;
+}
+
+/* Consumer side. Returns: 1 if a line was copied to buf, 0 if none is ready */
+static inline int log_ring_pop(log_ring_t *r, char *buf, int buf_len) {
+    const char *text = log_ring_peek(r);
+    if (!text) return 0;
+    snprintf(buf, buf_len, "%s", text);
+    log_ring_next(r);
+    return 1;
+}
+
+/* Lines dropped since the last call (consumer side) */
+static inline uint32_t log_ring_take_dropped(log_ring_t *r) {
+    return __atomic_exchange_n(&r->dropped, 0, __ATOMIC_RELAXED);
+}
+
+#endif /* LOG_RING_H */
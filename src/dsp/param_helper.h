@@ -8,6 +8,15 @@
  *   1. Define your params: static const param_def_t my_params[] = { ... };
  *   2. In get_param: return param_helper_get(my_params, COUNT, values, key, buf, len);
  *   3. In set_param: return param_helper_set(my_params, COUNT, values, key, val);
+ *
+ * Keyed dispatch without strcmp chains: build a param_hash_t over the key
+ * set once (param_hash_build / param_hash_build_defs, e.g. at module init),
+ * then param_hash_find() costs one hash and one strcmp per lookup.
+ *   param_hash_find(&hash, key) -> caller's id, or -1 for unknown keys
+ *
+ * Batched updates: param_json_next() walks the members of a flat JSON
+ * object ({"timbre":0.4,"engine":"FM"}) so a plugin can validate a whole
+ * batch before applying any of it.
  */
 
 #ifndef PARAM_HELPER_H
@@ -16,6 +25,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /* Parameter types */
 typedef enum {
@@ -111,6 +121,166 @@ static inline int param_helper_chain_params_json(
     return offset;
 }
 
+/* =====================================================================
+ * Perfect-hash key lookup
+ * ===================================================================== */
+
+#define PARAM_HASH_MAX_SLOTS 512
+#define PARAM_HASH_SEED_TRIES 4096
+
+typedef struct {
+    uint32_t seed;
+    uint32_t mask;                          /* slots - 1 (power of two) */
+    const char *keys[PARAM_HASH_MAX_SLOTS]; /* NULL = empty slot */
+    int16_t ids[PARAM_HASH_MAX_SLOTS];
+} param_hash_t;
+
+/* FNV-1a, with the seed folded into the offset basis */
+static inline uint32_t param_hash_key(const char *key, uint32_t seed) {
+    uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+    while (*key) {
+        h ^= (uint8_t)*key++;
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+/* Try one seed/size; returns 0 if every key lands in its own slot */
+static inline int param_hash_try(param_hash_t *h, const char *const *keys,
+                                 const int *ids, int count, uint32_t slots, uint32_t seed) {
+    memset(h->keys, 0, sizeof(h->keys));
+    h->seed = seed;
+    h->mask = slots - 1;
+    for (int i = 0; i < count; i++) {
+        uint32_t slot = param_hash_key(keys[i], seed) & h->mask;
+        if (h->keys[slot]) return -1;
+        h->keys[slot] = keys[i];
+        h->ids[slot] = (int16_t)ids[i];
+    }
+    return 0;
+}
+
+/*
+ * Search for a collision-free seed over `count` keys; ids[i] is what
+ * param_hash_find returns for keys[i] (NULL ids = position in keys).
+ * Keys must be unique and outlive the table.
+ * Returns: 0 on success, -1 if no perfect hash fits PARAM_HASH_MAX_SLOTS
+ */
+static inline int param_hash_build(param_hash_t *h, const char *const *keys,
+                                   const int *ids, int count) {
+    int positions[PARAM_HASH_MAX_SLOTS];
+    if (count <= 0 || count > PARAM_HASH_MAX_SLOTS / 2) return -1;
+    if (!ids) {
+        for (int i = 0; i < count; i++) positions[i] = i;
+        ids = positions;
+    }
+    uint32_t slots = 1;
+    while (slots < (uint32_t)count * 2) slots <<= 1;
+    for (; slots <= PARAM_HASH_MAX_SLOTS; slots <<= 1) {
+        for (uint32_t seed = 0; seed < PARAM_HASH_SEED_TRIES; seed++) {
+            if (param_hash_try(h, keys, ids, count, slots, seed) == 0) return 0;
+        }
+    }
+    memset(h->keys, 0, sizeof(h->keys));
+    h->mask = 0;
+    return -1;
+}
+
+/* Build over a param_def_t table; ids are indexes into defs */
+static inline int param_hash_build_defs(param_hash_t *h, const param_def_t *defs, int def_count) {
+    const char *keys[PARAM_HASH_MAX_SLOTS];
+    if (def_count > PARAM_HASH_MAX_SLOTS) return -1;
+    for (int i = 0; i < def_count; i++) keys[i] = defs[i].key;
+    return param_hash_build(h, keys, NULL, def_count);
+}
+
+/* Returns: the id registered for key, or -1 if key is not in the set */
+static inline int param_hash_find(const param_hash_t *h, const char *key) {
+    uint32_t slot = param_hash_key(key, h->seed) & h->mask;
+    const char *k = h->keys[slot];
+    if (!k || strcmp(k, key) != 0) return -1;
+    return h->ids[slot];
+}
+
+/*
+ * Hashed equivalents of param_helper_get / param_helper_set; hash must have
+ * been built with param_hash_build_defs over the same defs.
+ */
+static inline int param_helper_get_hashed(const param_hash_t *h, const param_def_t *defs,
+                                          const float *values, const char *key,
+                                          char *buf, int buf_len) {
+    int i = param_hash_find(h, key);
+    if (i < 0) return -1;
+    if (defs[i].type == PARAM_TYPE_INT) {
+        return snprintf(buf, buf_len, "%d", (int)values[defs[i].index]);
+    }
+    return snprintf(buf, buf_len, "%.3f", values[defs[i].index]);
+}
+
+static inline int param_helper_set_hashed(const param_hash_t *h, const param_def_t *defs,
+                                          float *values, const char *key, const char *val) {
+    int i = param_hash_find(h, key);
+    if (i < 0) return -1;
+    float v = (float)atof(val);
+    if (v < defs[i].min_val) v = defs[i].min_val;
+    if (v > defs[i].max_val) v = defs[i].max_val;
+    values[defs[i].index] = v;
+    return 0;
+}
+
+/* =====================================================================
+ * Flat JSON object iteration (for batched set_param)
+ * ===================================================================== */
+
+/*
+ * Read the next member of a flat JSON object. *pos starts at the opening
+ * brace and is advanced past each member. String values are unquoted (no
+ * escape handling); numbers and bare words are copied as-is. Keys and
+ * values longer than their buffers are truncated.
+ * Returns: 1 for a member, 0 at the closing brace, -1 on malformed input
+ */
+static inline int param_json_next(const char **pos, char *key, int key_len,
+                                  char *val, int val_len) {
+    const char *p = *pos;
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+    if (*p == '{' || *p == ',') p++;
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+    if (*p == '}') { *pos = p + 1; return 0; }
+    if (*p != '"') return -1;
+
+    int n = 0;
+    for (p++; *p && *p != '"'; p++) {
+        if (n < key_len - 1) key[n++] = *p;
+    }
+    if (*p != '"') return -1;
+    key[n] = '\0';
+    p++;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p != ':') return -1;
+    p++;
+    while (*p == ' ' || *p == '\t') p++;
+
+    n = 0;
+    if (*p == '"') {
+        for (p++; *p && *p != '"'; p++) {
+            if (n < val_len - 1) val[n++] = *p;
+        }
+        if (*p != '"') return -1;
+        p++;
+    } else {
+        for (; *p && *p != ',' && *p != '}' && *p != ' ' && *p != '\n'; p++) {
+            if (n < val_len - 1) val[n++] = *p;
+        }
+        if (n == 0) return -1;
+    }
+    val[n] = '\0';
+
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+    if (*p != ',' && *p != '}') return -1;
+    *pos = p;
+    return 1;
+}
+
 /* Convenience macro for array count */
 #define PARAM_DEF_COUNT(arr) (sizeof(arr) / sizeof((arr)[0]))
 
@@ -0,0 +1,63 @@
+/*
+ * param_queue.h - Lock-free parameter queue between control and audio threads
+ *
+ * Single-producer / single-consumer ring of small messages. The control
+ * thread (set_param) pushes, the audio thread drains at the start of each
+ * render block, so parameter state the renderer reads is only ever written
+ * by the renderer. No locks, no allocation; both ends are wait-free.
+ *
+ * If the ring fills up (a burst of more than PARAM_QUEUE_SIZE changes
+ * between two blocks) param_queue_push fails and the producer must fall back
+ * to flagging a full resync.
+ *
+ * Usage:
+ *   producer: param_msg_t m = { PARAM_MSG_SET, index, value };
+ *             if (param_queue_push(&q, &m) != 0) resync = 1;
+ *   consumer: while (param_queue_pop(&q, &m)) apply(&m);
+ */
+
+#ifndef PARAM_QUEUE_H
+#define PARAM_QUEUE_H
+
+#include <stdint.h>
+
+#define PARAM_QUEUE_SIZE 256        /* Power of two */
+
+/* Message types */
+#define PARAM_MSG_SET 0             /* params[index] = value */
+#define PARAM_MSG_RESET_VOICES 1    /* Silence all voices (preset change) */
+#define PARAM_MSG_SETTING 2         /* Render setting index = value */
+
+typedef struct {
+    int16_t type;
+    int16_t index;
+    float value;
+} param_msg_t;
+
+typedef struct {
+    param_msg_t msgs[PARAM_QUEUE_SIZE];
+    uint32_t head;                  /* Next slot to write; producer-owned */
+    uint32_t tail;                  /* Next slot to read; consumer-owned */
+} param_queue_t;
+
+/* Producer side. Returns: 0 on success, -1 if the queue is full */
+static inline int param_queue_push(param_queue_t *q, const param_msg_t *m) {
+    uint32_t head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= PARAM_QUEUE_SIZE) return -1;
+    q->msgs[head & (PARAM_QUEUE_SIZE - 1)] = *m;
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/* Consumer side. Returns: 1 if a message was read into *m, 0 if empty */
+static inline int param_queue_pop(param_queue_t *q, param_msg_t *m) {
+    uint32_t tail = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    if (tail == head) return 0;
+    *m = q->msgs[tail & (PARAM_QUEUE_SIZE - 1)];
+    __atomic_store_n(&q->tail, tail + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+#endif /* PARAM_QUEUE_H */
@@ -0,0 +1,127 @@
+/*
+ * perf_stats.h - Cheap render-time instrumentation for plugins
+ *
+ * Reads a free-running hardware counter (CNTVCT_EL0 on ARM64, the monotonic
+ * clock elsewhere) and keeps per-block statistics: last/average/peak block
+ * time, a histogram in 10%-of-budget buckets and an overrun count.
+ *
+ * Build with -DBRAIDS_PERF_STATS=0 to compile all instrumentation out; the
+ * PERF_* macros then expand to nothing. perf_now() itself is always
+ * available for code that needs the clock for its own decisions.
+ *
+ * Usage:
+ *   PERF_BEGIN(t0);
+ *   ... render ...
+ *   PERF_END(t0, elapsed);            // elapsed = ticks since PERF_BEGIN
+ *   perf_block_record(&stats, elapsed, realtime_ticks, budget_ticks);
+ */
+
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef BRAIDS_PERF_STATS
+#define BRAIDS_PERF_STATS 1
+#endif
+
+/* Free-running counter, in ticks of perf_ticks_per_sec() */
+static inline uint64_t perf_now(void) {
+#if defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline uint64_t perf_ticks_per_sec(void) {
+#if defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(v));
+    return v ? v : 1;
+#else
+    return 1000000000ull;
+#endif
+}
+
+#if BRAIDS_PERF_STATS
+
+#define PERF_BEGIN(var) uint64_t var = perf_now()
+#define PERF_END(var, elapsed) uint64_t elapsed = perf_now() - (var)
+
+#else
+
+#define PERF_BEGIN(var)
+#define PERF_END(var, elapsed)
+
+#endif /* BRAIDS_PERF_STATS */
+
+/* Histogram: 10 buckets of 10% of the block budget, plus one for overruns */
+#define PERF_HIST_BUCKETS 11
+
+typedef struct {
+    uint64_t blocks;
+    uint64_t total_ticks;
+    uint64_t last_ticks;
+    uint64_t peak_ticks;
+    uint64_t overruns;
+    uint32_t histogram[PERF_HIST_BUCKETS];
+} perf_block_stats_t;
+
+static inline void perf_block_reset(perf_block_stats_t *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+/*
+ * Record one block. realtime_ticks is the duration of the block's audio
+ * (100% of budget); budget_ticks is the configured overrun threshold.
+ */
+static inline void perf_block_record(perf_block_stats_t *s, uint64_t ticks,
+                                     uint64_t realtime_ticks, uint64_t budget_ticks) {
+    s->blocks++;
+    s->total_ticks += ticks;
+    s->last_ticks = ticks;
+    if (ticks > s->peak_ticks) s->peak_ticks = ticks;
+    if (ticks > budget_ticks) s->overruns++;
+
+    uint64_t bucket = realtime_ticks ? (ticks * 10) / realtime_ticks : 0;
+    if (bucket >= PERF_HIST_BUCKETS) bucket = PERF_HIST_BUCKETS - 1;
+    s->histogram[bucket]++;
+}
+
+/*
+ * Serialise the block statistics as JSON object members (no braces), so the
+ * caller can append its own fields. Times are reported in microseconds and
+ * as a percentage of the real-time block duration.
+ * Returns: length written, or -1 if the buffer is too small
+ */
+static inline int perf_block_json(const perf_block_stats_t *s, uint64_t ticks_per_sec,
+                                  uint64_t realtime_ticks, char *buf, int buf_len) {
+    double us_per_tick = 1e6 / (double)ticks_per_sec;
+    double avg = s->blocks ? (double)s->total_ticks / (double)s->blocks : 0.0;
+    double pct = realtime_ticks ? 100.0 / (double)realtime_ticks : 0.0;
+    int offset = snprintf(buf, buf_len,
+        "\"blocks\":%llu,\"last_us\":%.1f,\"avg_us\":%.1f,\"peak_us\":%.1f,"
+        "\"avg_pct\":%.2f,\"peak_pct\":%.2f,\"overruns\":%llu,"
+        "\"histogram\":{\"bucket_pct\":10,\"counts\":[",
+        (unsigned long long)s->blocks,
+        s->last_ticks * us_per_tick, avg * us_per_tick, s->peak_ticks * us_per_tick,
+        avg * pct, s->peak_ticks * pct,
+        (unsigned long long)s->overruns);
+    for (int i = 0; i < PERF_HIST_BUCKETS && offset < buf_len; i++) {
+        offset += snprintf(buf + offset, buf_len - offset, "%s%u",
+                           i ? "," : "", s->histogram[i]);
+    }
+    if (offset < buf_len) offset += snprintf(buf + offset, buf_len - offset, "]}");
+    if (offset >= buf_len) return -1;
+    return offset;
+}
+
+#endif /* PERF_STATS_H */
@@ -0,0 +1,55 @@
+/*
+ * plugin_api_v1.h - Move Anything plugin API definitions
+ *
+ * Host and plugin ABI shared by the DSP plugin and the host-less tools
+ * (benchmark, offline renderer) that load it through move_plugin_init_v2.
+ */
+
+#ifndef PLUGIN_API_V1_H
+#define PLUGIN_API_V1_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define MOVE_PLUGIN_API_VERSION 1
+#define MOVE_SAMPLE_RATE 44100
+#define MOVE_FRAMES_PER_BLOCK 128
+#define MOVE_MIDI_SOURCE_INTERNAL 0
+#define MOVE_MIDI_SOURCE_EXTERNAL 2
+
+typedef struct host_api_v1 {
+    uint32_t api_version;
+    int sample_rate;
+    int frames_per_block;
+    uint8_t *mapped_memory;
+    int audio_out_offset;
+    int audio_in_offset;
+    void (*log)(const char *msg);
+    int (*midi_send_internal)(const uint8_t *msg, int len);
+    int (*midi_send_external)(const uint8_t *msg, int len);
+} host_api_v1_t;
+
+#define MOVE_PLUGIN_API_VERSION_2 2
+
+typedef struct plugin_api_v2 {
+    uint32_t api_version;
+    void* (*create_instance)(const char *module_dir, const char *json_defaults);
+    void (*destroy_instance)(void *instance);
+    void (*on_midi)(void *instance, const uint8_t *msg, int len, int source);
+    void (*set_param)(void *instance, const char *key, const char *val);
+    int (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+    int (*get_error)(void *instance, char *buf, int buf_len);
+    void (*render_block)(void *instance, int16_t *out_interleaved_lr, int frames);
+} plugin_api_v2_t;
+
+typedef plugin_api_v2_t* (*move_plugin_init_v2_fn)(const host_api_v1_t *host);
+#define MOVE_PLUGIN_INIT_V2_SYMBOL "move_plugin_init_v2"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLUGIN_API_V1_H */
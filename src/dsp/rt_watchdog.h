@@ -0,0 +1,172 @@
+/*
+ * rt_watchdog.h - Debug check that the audio path never blocks
+ *
+ * Built with BRAIDS_RT_WATCHDOG=1, the plugin links with ld --wrap for the
+ * calls that may allocate, take a lock, sleep or do file I/O (see build.sh),
+ * so every call to them from the plugin's and Braids' objects lands in a
+ * __wrap_ function here first. While the calling thread is inside an
+ * RT_WATCH_SCOPE (render_block, on_midi, a voice job on a worker) the call
+ * is counted against its category, and the first of each category is logged
+ * with its caller's address; the call then goes through as normal. Calls
+ * made inside libc (or by the host) on the plugin's behalf are not seen.
+ *
+ * Without the flag, RT_WATCH_SCOPE is empty and nothing is wrapped.
+ *
+ * Include in one translation unit only (it defines the wrappers).
+ */
+
+#ifndef RT_WATCHDOG_H
+#define RT_WATCHDOG_H
+
+#include <stdint.h>
+
+#ifndef BRAIDS_RT_WATCHDOG
+#define BRAIDS_RT_WATCHDOG 0
+#endif
+
+enum RtWatchKind {
+    RT_WATCH_ALLOC = 0,     /* malloc, calloc, realloc, posix_memalign */
+    RT_WATCH_FREE,
+    RT_WATCH_FILE,          /* open, read, write, close, fopen, fread, ... */
+    RT_WATCH_LOCK,          /* pthread mutex / condition variable waits */
+    RT_WATCH_SLEEP,         /* usleep, nanosleep */
+    RT_WATCH_KINDS
+};
+
+#if BRAIDS_RT_WATCHDOG
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char *const g_rt_watch_names[RT_WATCH_KINDS] = {
+    "alloc", "free", "file", "lock", "sleep"
+};
+
+static __thread int g_rt_watch_depth;          /* RT scopes the thread is in */
+static uint64_t g_rt_watch_counts[RT_WATCH_KINDS];
+
+/* Reports a violation; defined by the plugin (must not call wrapped functions) */
+static void rt_watch_report(int kind, const void *caller);
+
+struct RtWatchScope {
+    RtWatchScope() { g_rt_watch_depth++; }
+    ~RtWatchScope() { g_rt_watch_depth--; }
+};
+
+#define RT_WATCH_SCOPE() RtWatchScope rt_watch_scope_
+
+static inline void rt_watch_note(int kind, const void *caller) {
+    if (g_rt_watch_depth <= 0) return;
+    g_rt_watch_depth = -g_rt_watch_depth;  /* Not re-entered by the report */
+    if (__atomic_fetch_add(&g_rt_watch_counts[kind], 1, __ATOMIC_RELAXED) == 0) {
+        rt_watch_report(kind, caller);
+    }
+    g_rt_watch_depth = -g_rt_watch_depth;
+}
+
+static inline uint64_t rt_watch_count(int kind) {
+    return __atomic_load_n(&g_rt_watch_counts[kind], __ATOMIC_RELAXED);
+}
+
+#define RT_WATCH(kind) rt_watch_note(kind, __builtin_return_address(0))
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+int __real_posix_memalign(void **out, size_t alignment, size_t size);
+void __real_free(void *ptr);
+int __real_open(const char *path, int flags, ...);
+ssize_t __real_read(int fd, void *buf, size_t count);
+ssize_t __real_write(int fd, const void *buf, size_t count);
+int __real_close(int fd);
+FILE *__real_fopen(const char *path, const char *mode);
+size_t __real_fread(void *ptr, size_t size, size_t count, FILE *f);
+size_t __real_fwrite(const void *ptr, size_t size, size_t count, FILE *f);
+int __real_fclose(FILE *f);
+int __real_pthread_mutex_lock(pthread_mutex_t *m);
+int __real_pthread_cond_wait(pthread_cond_t *c, pthread_mutex_t *m);
+int __real_usleep(useconds_t usec);
+int __real_nanosleep(const struct timespec *req, struct timespec *rem);
+
+void *__wrap_malloc(size_t size) {
+    RT_WATCH(RT_WATCH_ALLOC);
+    return __real_malloc(size);
+}
+void *__wrap_calloc(size_t count, size_t size) {
+    RT_WATCH(RT_WATCH_ALLOC);
+    return __real_calloc(count, size);
+}
+void *__wrap_realloc(void *ptr, size_t size) {
+    RT_WATCH(RT_WATCH_ALLOC);
+    return __real_realloc(ptr, size);
+}
+int __wrap_posix_memalign(void **out, size_t alignment, size_t size) {
+    RT_WATCH(RT_WATCH_ALLOC);
+    return __real_posix_memalign(out, alignment, size);
+}
+void __wrap_free(void *ptr) {
+    RT_WATCH(RT_WATCH_FREE);
+    __real_free(ptr);
+}
+int __wrap_open(const char *path, int flags, mode_t mode) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_open(path, flags, mode);
+}
+ssize_t __wrap_read(int fd, void *buf, size_t count) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_read(fd, buf, count);
+}
+ssize_t __wrap_write(int fd, const void *buf, size_t count) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_write(fd, buf, count);
+}
+int __wrap_close(int fd) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_close(fd);
+}
+FILE *__wrap_fopen(const char *path, const char *mode) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_fopen(path, mode);
+}
+size_t __wrap_fread(void *ptr, size_t size, size_t count, FILE *f) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_fread(ptr, size, count, f);
+}
+size_t __wrap_fwrite(const void *ptr, size_t size, size_t count, FILE *f) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_fwrite(ptr, size, count, f);
+}
+int __wrap_fclose(FILE *f) {
+    RT_WATCH(RT_WATCH_FILE);
+    return __real_fclose(f);
+}
+int __wrap_pthread_mutex_lock(pthread_mutex_t *m) {
+    RT_WATCH(RT_WATCH_LOCK);
+    return __real_pthread_mutex_lock(m);
+}
+int __wrap_pthread_cond_wait(pthread_cond_t *c, pthread_mutex_t *m) {
+    RT_WATCH(RT_WATCH_LOCK);
+    return __real_pthread_cond_wait(c, m);
+}
+int __wrap_usleep(useconds_t usec) {
+    RT_WATCH(RT_WATCH_SLEEP);
+    return __real_usleep(usec);
+}
+int __wrap_nanosleep(const struct timespec *req, struct timespec *rem) {
+    RT_WATCH(RT_WATCH_SLEEP);
+    return __real_nanosleep(req, rem);
+}
+}
+
+#else
+
+#define RT_WATCH_SCOPE() do {} while (0)
+
+#endif /* BRAIDS_RT_WATCHDOG */
+
+#endif /* RT_WATCHDOG_H */
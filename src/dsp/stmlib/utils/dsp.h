@@ -30,13 +30,25 @@
 #ifndef STMLIB_UTILS_DSP_H_
 #define STMLIB_UTILS_DSP_H_
 
+#include <string.h>
+
 #include "stmlib/stmlib.h"
 
 namespace stmlib {
 
+// Four lanes of phases / samples, as GCC vector extensions (NEON on ARM64,
+// SSE on x86).
+typedef uint32_t PhaseLanes __attribute__((vector_size(16)));
+typedef int32_t SampleLanes __attribute__((vector_size(16)));
+
+const size_t kNumLanes = 4;
+
 inline int16_t Interpolate824(const int16_t* table, uint32_t phase)
   __attribute__((always_inline));
 
+inline SampleLanes Interpolate824(const int16_t* table, PhaseLanes phase)
+  __attribute__((always_inline));
+
 inline uint16_t Interpolate824(const uint16_t* table, uint32_t phase)
   __attribute__((always_inline));
 
@@ -97,6 +109,37 @@ inline int16_t Interpolate824(const int16_t* table, uint32_t phase) {
   return a + ((b - a) * static_cast<int32_t>((phase >> 8) & 0xffff) >> 16);
 }
 
+// Four phases in one table at once. Each lane reads its two neighbouring
+// entries with a single 32-bit load (a scalar gather); splitting them and the
+// interpolation run on all lanes together. Each lane gives exactly the scalar
+// Interpolate824's result.
+inline SampleLanes Interpolate824(const int16_t* table, PhaseLanes phase) {
+  PhaseLanes index = phase >> 24;
+  SampleLanes pair;
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    int32_t word;
+    memcpy(&word, table + index[i], sizeof(word));
+    pair[i] = word;
+  }
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "table[index] is low");
+  SampleLanes a = pair << 16 >> 16;
+  SampleLanes b = pair >> 16;
+  SampleLanes fractional = (SampleLanes)((phase >> 8) & 0xffff);
+  return a + ((b - a) * fractional >> 16);
+}
+
+inline int32_t SumLanes(SampleLanes x) {
+  return (x[0] + x[1]) + (x[2] + x[3]);
+}
+
+// CLIP on four lanes.
+inline SampleLanes ClipLanes(SampleLanes x) {
+  const SampleLanes lo = { -32767, -32767, -32767, -32767 };
+  const SampleLanes hi = { 32767, 32767, 32767, 32767 };
+  x = x < lo ? lo : x;
+  return x > hi ? hi : x;
+}
+
 inline uint16_t Interpolate824(const uint16_t* table, uint32_t phase) {
   uint32_t a = table[phase >> 24];
   uint32_t b = table[(phase >> 24) + 1];
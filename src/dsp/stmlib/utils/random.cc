@@ -2,6 +2,6 @@
 
 namespace stmlib {
 
-uint32_t Random::rng_state_ = 0x21;
+__thread uint32_t Random::rng_state_ = 0x21;
 
 }  // namespace stmlib
@@ -29,6 +29,8 @@
 #ifndef STMLIB_UTILS_RANDOM_H_
 #define STMLIB_UTILS_RANDOM_H_
 
+#include <string.h>
+
 #include "stmlib/stmlib.h"
 
 namespace stmlib {
@@ -47,7 +49,48 @@ class Random {
   }
   
   static inline int16_t GetSample() {
-    return static_cast<int16_t>(GetWord() >> 16);
+    return ToSample(GetWord());
+  }
+
+  static inline int16_t ToSample(uint32_t word) {
+    return static_cast<int16_t>(word >> 16);
+  }
+
+  // Stores the next n words of the stream, exactly as n calls to GetWord()
+  // would return them, but four at a time: each lane of a vector runs the
+  // generator four steps ahead of the previous lane.
+  static inline void Fill(uint32_t* words, size_t n) {
+    if (!n) {
+      return;
+    }
+    uint32_t x = rng_state_;
+    WordLanes lanes = {
+        kMultiplier * x + kIncrement,
+        kMultiplier2 * x + kIncrement2,
+        kMultiplier3 * x + kIncrement3,
+        kMultiplier4 * x + kIncrement4 };
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      memcpy(words + i, &lanes, sizeof(lanes));
+      lanes = lanes * kMultiplier4 + kIncrement4;
+    }
+    for (size_t j = 0; i < n; ++i, ++j) {
+      words[i] = lanes[j];
+    }
+    rng_state_ = words[n - 1];
+  }
+
+  // Advances the stream by n words, as n calls to GetWord() would, four
+  // steps at a time.
+  static inline void Skip(size_t n) {
+    uint32_t x = rng_state_;
+    for (; n >= 4; n -= 4) {
+      x = x * kMultiplier4 + kIncrement4;
+    }
+    for (; n; --n) {
+      x = x * kMultiplier + kIncrement;
+    }
+    rng_state_ = x;
   }
 
   static inline float GetFloat() {
@@ -55,7 +98,23 @@ class Random {
   }
 
  private:
-  static uint32_t rng_state_;
+  typedef uint32_t WordLanes __attribute__((vector_size(16)));
+
+  // k steps of x = a * x + c are x = a^k * x + c * (a^(k-1) + ... + 1).
+  static const uint32_t kMultiplier = 1664525;
+  static const uint32_t kIncrement = 1013904223;
+  static const uint32_t kMultiplier2 = kMultiplier * kMultiplier;
+  static const uint32_t kMultiplier3 = kMultiplier2 * kMultiplier;
+  static const uint32_t kMultiplier4 = kMultiplier3 * kMultiplier;
+  static const uint32_t kIncrement2 = kIncrement * (kMultiplier + 1);
+  static const uint32_t kIncrement3 = kIncrement * (kMultiplier2 + kMultiplier + 1);
+  static const uint32_t kIncrement4 =
+      kIncrement * (kMultiplier3 + kMultiplier2 + kMultiplier + 1);
+
+  // Per thread, so that voices rendered on worker threads can each run their
+  // own stream (see Seed / state). Default TLS model: the plugin is loaded
+  // with dlopen, which cannot count on room in the static TLS block.
+  static __thread uint32_t rng_state_;
 
   DISALLOW_COPY_AND_ASSIGN(Random);
 };
@@ -0,0 +1,217 @@
+/*
+ * unison_lanes.h - Detuned oscillator stack for the analog engines
+ *
+ * With unison above 1, a voice adds up to 7 detuned copies of its engine's
+ * basic waveform around the engine's own output: a band-limited saw or
+ * square rendered exactly like braids::AnalogOscillator's (no sync, no pulse
+ * width), polyBLEP residues included. The copies live in 4-lane vectors, one
+ * lane per copy, so their phases, phase increment ramps and the
+ * ThisBlepSample / NextBlepSample corrections all advance in parallel and
+ * branch-free, with no per-copy voice, envelope or filter.
+ *
+ * The lane types use GCC vector extensions (NEON on ARM64, SSE on x86). The
+ * BLEP's fractional reset time, phase / (increment >> 16), is a multiply by
+ * a per-block float reciprocal instead of the integer division braids uses.
+ *
+ * Usage:
+ *   unison_bank_reset(&bank);                          (note on)
+ *   osc.Render(sync, buffer, size);
+ *   unison_bank_render(&bank, wave, copies, pitch, spread, buffer, size);
+ */
+
+#ifndef UNISON_LANES_H
+#define UNISON_LANES_H
+
+#include <stdint.h>
+
+#include "braids/resources.h"
+#include "braids/settings.h"
+#include "voice_lanes.h"
+
+#define UNISON_MAX 8            /* Copies per note, the engine's own included */
+#define UNISON_GROUPS 2         /* 4-lane vectors holding the other 7 */
+#define UNISON_DETUNE_MAX 128   /* Outermost copy at spread 1: a semitone (1/128 st) */
+
+/* Waveform of the copies */
+enum UnisonWave {
+    UNISON_WAVE_NONE = 0,   /* Engine has no saw / square core: unison is ignored */
+    UNISON_WAVE_SAW,
+    UNISON_WAVE_SQUARE,
+};
+
+typedef struct {
+    lane_u32 phase[UNISON_GROUPS];
+    lane_u32 increment[UNISON_GROUPS];      /* Reached at the end of the last block */
+    lane_s32 next_sample[UNISON_GROUPS];    /* BLEP residue for the next sample */
+    lane_s32 high[UNISON_GROUPS];           /* Square: -1 in the upper half */
+    int groups;                             /* Groups running since the strike */
+
+    /* Copies' target increments, kept while pitch, spread and count hold */
+    lane_u32 target[UNISON_GROUPS];
+    lane_s32 on[UNISON_GROUPS];             /* -1 for the lanes in use */
+    int32_t target_pitch;
+    int32_t target_spread;
+    int target_copies;                      /* 0 = nothing cached */
+} unison_bank_t;
+
+/* 32768 / sqrt(copies): N uncorrelated copies sum to about sqrt(N) times one */
+static const int32_t g_unison_gain[UNISON_MAX + 1] = {
+    32768, 32768, 23170, 18919, 16384, 14654, 13377, 12385, 11585
+};
+
+static inline void unison_bank_reset(unison_bank_t *b) {
+    for (int g = 0; g < UNISON_GROUPS; g++) {
+        for (int i = 0; i < VOICE_LANE_WIDTH; i++) {
+            /* Golden-ratio spacing: copies start spread out, deterministically */
+            b->phase[g][i] = (uint32_t)(g * VOICE_LANE_WIDTH + i + 1) * 0x9e3779b9u;
+        }
+    }
+    b->groups = 0;
+    b->target_copies = 0;
+}
+
+/* Copy of braids::AnalogOscillator::ComputePhaseIncrement */
+static inline uint32_t unison_phase_increment(int32_t pitch) {
+    if (pitch >= 128 * 128) pitch = 128 * 128 - 1;
+    if (pitch < 0) pitch = 0;
+    int32_t ref_pitch = pitch - 128 * 128;
+    int num_shifts = 0;
+    while (ref_pitch < 0) {
+        ref_pitch += 12 * 128;
+        num_shifts++;
+    }
+    uint32_t a = braids::lut_oscillator_increments[ref_pitch >> 4];
+    uint32_t b = braids::lut_oscillator_increments[(ref_pitch >> 4) + 1];
+    uint32_t increment = a + ((int32_t)(b - a) * (ref_pitch & 0xf) >> 4);
+    return increment >> num_shifts;
+}
+
+/* Pitch offset of copy j (1..copies-1): alternately above and below, widening */
+static inline int32_t unison_detune(int j, int copies, int32_t spread) {
+    int32_t d = spread * ((j + 1) / 2) / (copies / 2);
+    return (j & 1) ? d : -d;
+}
+
+/* The analog engines whose core is a plain saw or square */
+static inline int unison_wave(int shape) {
+    switch (shape) {
+        case braids::MACRO_OSC_SHAPE_CSAW:
+        case braids::MACRO_OSC_SHAPE_SAW_SQUARE:
+        case braids::MACRO_OSC_SHAPE_SAW_SUB:
+        case braids::MACRO_OSC_SHAPE_SAW_SYNC:
+        case braids::MACRO_OSC_SHAPE_TRIPLE_SAW:
+            return UNISON_WAVE_SAW;
+        case braids::MACRO_OSC_SHAPE_SQUARE_SUB:
+        case braids::MACRO_OSC_SHAPE_SQUARE_SYNC:
+        case braids::MACRO_OSC_SHAPE_TRIPLE_SQUARE:
+            return UNISON_WAVE_SQUARE;
+        default:
+            return UNISON_WAVE_NONE;
+    }
+}
+
+/* AnalogOscillator::ThisBlepSample / NextBlepSample on four lanes */
+static inline lane_s32 lane_this_blep(lane_u32 t) {
+    return (lane_s32)(t * t >> 18);
+}
+
+static inline lane_s32 lane_next_blep(lane_u32 t) {
+    t = 65535 - t;
+    return -(lane_s32)(t * t >> 18);
+}
+
+/* Fractional reset time x / (increment >> 16), clamped to 65535 */
+static inline lane_u32 lane_blep_time(lane_u32 x, lane_f32 inv) {
+    lane_u32 t = __builtin_convertvector(__builtin_convertvector(x, lane_f32) * inv, lane_u32);
+    return t > 65535 ? (lane_u32){ 65535, 65535, 65535, 65535 } : t;
+}
+
+/*
+ * Add copies 1..copies-1 of wave at pitch (detuned by up to +/-spread, in
+ * 1/128 semitones) to the engine output in buffer, then scale the stack by
+ * g_unison_gain and clip. Phase increments ramp across the block like
+ * AnalogOscillator's, from where the last block ended.
+ */
+static void unison_bank_render(unison_bank_t *b, int wave, int copies, int16_t pitch,
+                               int32_t spread, int16_t *buffer, int size) {
+    const lane_u32 half = { 0x80000000u, 0x80000000u, 0x80000000u, 0x80000000u };
+    int groups = (copies - 1 + VOICE_LANE_WIDTH - 1) / VOICE_LANE_WIDTH;
+    lane_u32 increment[UNISON_GROUPS];
+    lane_u32 step[UNISON_GROUPS];
+    lane_f32 inv[UNISON_GROUPS];
+    const lane_s32 *on = b->on;
+
+    if (pitch != b->target_pitch || spread != b->target_spread || copies != b->target_copies) {
+        for (int g = 0; g < groups; g++) {
+            for (int i = 0; i < VOICE_LANE_WIDTH; i++) {
+                int j = g * VOICE_LANE_WIDTH + i + 1;
+                /* Unused lanes run at a harmless pitch and are masked out */
+                int32_t detune = j < copies ? unison_detune(j, copies, spread) : 0;
+                b->target[g][i] = unison_phase_increment(pitch + detune);
+                b->on[g][i] = j < copies ? -1 : 0;
+            }
+        }
+        b->target_pitch = pitch;
+        b->target_spread = spread;
+        b->target_copies = copies;
+    }
+
+    for (int g = 0; g < groups; g++) {
+        lane_u32 target = b->target[g];
+        if (g >= b->groups) {
+            /* New since the strike (or since unison grew): start at pitch */
+            b->increment[g] = target;
+            b->high[g] = b->phase[g] >= half;
+            b->next_sample[g] = wave == UNISON_WAVE_SQUARE
+                ? (b->high[g] & 32767) : (lane_s32)(b->phase[g] >> 17);
+        }
+        increment[g] = b->increment[g];
+        step[g] = (lane_u32)((lane_s32)(target - increment[g]) / lane_s32_set1(size));
+        /* Reset times use the mid-block increment: exact unless gliding */
+        lane_u32 mid = increment[g] + step[g] * (uint32_t)(size / 2);
+        inv[g] = 1.0f / __builtin_convertvector(mid >> 16, lane_f32);
+    }
+    b->groups = groups;
+
+    int32_t gain = g_unison_gain[copies];
+    for (int s = 0; s < size; s++) {
+        lane_s32 sum = lane_s32_set1(0);
+        for (int g = 0; g < groups; g++) {
+            lane_u32 inc = increment[g] += step[g];
+            lane_u32 phase = b->phase[g] += inc;
+            lane_s32 this_sample = b->next_sample[g];
+            lane_s32 next_sample = lane_s32_set1(0);
+            lane_s32 wrapped = phase < inc;
+            lane_u32 t = lane_blep_time(phase, inv[g]);
+
+            if (wave == UNISON_WAVE_SQUARE) {
+                lane_s32 high = b->high[g];
+                lane_s32 upper = phase >= half;
+                lane_s32 rise = ~high & upper;
+                lane_u32 t_rise = lane_blep_time(phase - half, inv[g]);
+                this_sample += rise & lane_this_blep(t_rise);
+                next_sample += rise & lane_next_blep(t_rise);
+                high |= rise;
+                lane_s32 fall = high & wrapped;
+                this_sample -= fall & lane_this_blep(t);
+                next_sample -= fall & lane_next_blep(t);
+                b->high[g] = high & ~fall;
+                next_sample += upper & 32767;
+            } else {
+                this_sample -= wrapped & lane_this_blep(t);
+                next_sample -= wrapped & lane_next_blep(t);
+                next_sample += (lane_s32)(phase >> 17);
+            }
+            b->next_sample[g] = next_sample;
+            sum += on[g] & ((this_sample - 16384) << 1);
+        }
+        int32_t stack = buffer[s] + sum[0] + sum[1] + sum[2] + sum[3];
+        int32_t out = (int32_t)((int64_t)stack * gain >> 15);
+        if (out > 32767) out = 32767;
+        if (out < -32768) out = -32768;
+        buffer[s] = (int16_t)out;
+    }
+    for (int g = 0; g < groups; g++) b->increment[g] = increment[g];
+}
+
+#endif /* UNISON_LANES_H */
@@ -0,0 +1,253 @@
+/*
+ * voice_lanes.h - Voice-parallel post-oscillator stage
+ *
+ * Everything that happens to a voice after MacroOscillator::Render (amp and
+ * filter envelope, SVF, velocity/volume gain and the mix) is kept here in
+ * structure-of-arrays form: one 4-lane vector per quantity, one lane per
+ * voice. A single per-sample kernel then processes four voices at once. The
+ * envelopes arrive as per-voice level buffers (SimpleADSR::render, which
+ * works in whole stage segments), so the kernel only reads them.
+ * The mono mix bus is turned into the host's stereo int16 output by one
+ * final pass (volume, a single saturation, L = R), four frames at a time.
+ *
+ * The lane types use GCC vector extensions, which lower to NEON on ARM64
+ * (and SSE on x86 for host builds), so the same source is what runs on Move
+ * and what the host-side tools measure. All per-lane state transitions are
+ * computed branch-free with masks; the only scalar work left is the SVF
+ * cutoff LUT lookup for lanes whose quantised cutoff changed, which can run
+ * at a reduced control rate.
+ *
+ * Usage:
+ *   1. Load each voice's envelope buffers / SVF state into a group (lane = voice)
+ *   2. voice_lanes_render(&group, inputs, &filter, mix, frames);
+ *   3. Store the state back and retire voices whose alive lane went to 0
+ *      (or whose peak stayed below audibility)
+ *   4. voice_lanes_output(mix, volume, clip, out, frames);
+ */
+
+#ifndef VOICE_LANES_H
+#define VOICE_LANES_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "braids/resources.h"
+#include "stmlib/utils/dsp.h"
+
+#define VOICE_LANE_WIDTH 4
+
+typedef float lane_f32 __attribute__((vector_size(16)));
+typedef int32_t lane_s32 __attribute__((vector_size(16)));
+typedef uint32_t lane_u32 __attribute__((vector_size(16)));
+
+/* Output saturation (clip param) */
+#define VOICE_LANES_CLIP_HARD 0
+#define VOICE_LANES_CLIP_SOFT 1
+
+/* Four voices' post-oscillator state */
+typedef struct {
+    /* Envelope levels for the block, one buffer of `frames` per lane */
+    const float *amp[VOICE_LANE_WIDTH];
+    const float *filt[VOICE_LANE_WIDTH];
+    lane_s32 idle_at;       /* Sample the amp envelope went idle on (frames if not) */
+
+    /* braids::Svf state (BP output, no punch) */
+    lane_s32 lp;
+    lane_s32 bp;
+    lane_s32 f;
+    lane_s32 damp;
+    lane_s32 frequency;     /* Quantised cutoff that f was looked up for */
+
+    lane_f32 gain;          /* velocity / 127 * normalised volume */
+    lane_f32 peak;          /* Largest |output| so far (silence detection); start at 0 */
+    lane_s32 gate;          /* -1 while the key is held */
+    lane_s32 alive;         /* -1 while the voice sounds, 0 once retired */
+} voice_lane_group_t;
+
+/* Filter settings shared by all lanes */
+typedef struct {
+    int enabled;
+    const float *cutoff;    /* Base cutoff 0-1, one value per sample (smoothed) */
+    float env_amount;       /* 0-1 */
+    int control_period;     /* Samples per filter envelope / LUT update */
+} voice_lane_filter_t;
+
+static inline lane_f32 lane_f32_set1(float x) {
+    lane_f32 v = { x, x, x, x };
+    return v;
+}
+
+static inline lane_s32 lane_s32_set1(int32_t x) {
+    lane_s32 v = { x, x, x, x };
+    return v;
+}
+
+static inline int lane_any(lane_s32 mask) {
+    return (mask[0] | mask[1] | mask[2] | mask[3]) != 0;
+}
+
+/* Lane i = buf[i][s] */
+static inline lane_f32 lane_gather(const float *const buf[VOICE_LANE_WIDTH], int s) {
+    lane_f32 v = { buf[0][s], buf[1][s], buf[2][s], buf[3][s] };
+    return v;
+}
+
+static inline lane_s32 lane_clip16(lane_s32 x) {
+    const lane_s32 lo = lane_s32_set1(-32767);
+    const lane_s32 hi = lane_s32_set1(32767);
+    x = x < lo ? lo : x;
+    x = x > hi ? hi : x;
+    return x;
+}
+
+/* Look up the SVF coefficient for lanes whose quantised cutoff changed */
+static inline void lane_svf_update(voice_lane_group_t *g, lane_s32 frequency, lane_s32 mask) {
+    lane_s32 changed = (frequency != g->frequency) & mask;
+    if (!lane_any(changed)) return;
+    for (int i = 0; i < VOICE_LANE_WIDTH; i++) {
+        if (!changed[i]) continue;
+        g->f[i] = stmlib::Interpolate824(braids::lut_svf_cutoff, (uint32_t)frequency[i] << 17);
+        g->frequency[i] = frequency[i];
+    }
+}
+
+/* Quantised cutoff (braids::Svf frequency units) from the filter envelope at sample s */
+static inline lane_s32 lane_cutoff(const voice_lane_filter_t *filter, lane_f32 filt_level,
+                                   int s) {
+    const lane_f32 one = lane_f32_set1(1.0f);
+    lane_f32 mod = lane_f32_set1(filter->cutoff[s]) + filt_level * filter->env_amount;
+    mod = mod > one ? one : mod;
+    return __builtin_convertvector(mod * 127.0f, lane_s32) << 7;
+}
+
+/*
+ * Render the post-oscillator stage of up to four voices.
+ *   in:   per-lane oscillator output, `frames` samples each (never NULL;
+ *         point unused lanes at a silent buffer)
+ *   mix:  accumulated (+=) mono output, in int16 units, before saturation
+ * Lanes whose alive mask is 0 are left untouched and contribute nothing.
+ *
+ * With filter->control_period > 1 the filter envelope and the cutoff LUT
+ * are read once per period, at its last sample, and the SVF coefficient is
+ * ramped linearly in between; a period of 1 updates them every sample.
+ * filter->cutoff is read at the end of each period, or every sample with a
+ * period of 1. The caller renders g->filt whether or not the filter is
+ * enabled, so a filter switched back on picks up the envelope where it is.
+ */
+static inline void voice_lanes_render(voice_lane_group_t *g,
+                                      const int16_t *const in[VOICE_LANE_WIDTH],
+                                      const voice_lane_filter_t *filter,
+                                      float *mix, int frames) {
+    const lane_f32 zero = lane_f32_set1(0.0f);
+    int ramped = filter->enabled && filter->control_period > 1;
+    int period = ramped ? filter->control_period : frames;
+
+    for (int start = 0; start < frames; start += period) {
+        int len = frames - start;
+        if (len > period) len = period;
+        if (!lane_any(g->alive)) break;
+
+        /* Control rate: aim the coefficient at the envelope's end-of-segment level */
+        lane_s32 f_ramp = g->f << 8;    /* 24.8 fixed point */
+        lane_s32 f_step = lane_s32_set1(0);
+        if (ramped) {
+            int last = start + len - 1;
+            lane_svf_update(g, lane_cutoff(filter, lane_gather(g->filt, last), last), g->alive);
+            f_step = ((g->f << 8) - f_ramp) / len;
+        }
+        lane_s32 f_target = g->f;
+
+        for (int s = start; s < start + len; s++) {
+            if (!lane_any(g->alive)) break;
+            lane_s32 alive = g->alive;
+
+            /* Released voices retire on the sample the amp envelope goes idle */
+            alive &= g->gate | (lane_s32_set1(s) < g->idle_at);
+
+            lane_f32 osc = { (float)in[0][s], (float)in[1][s], (float)in[2][s], (float)in[3][s] };
+            lane_s32 sample = __builtin_convertvector(osc * lane_gather(g->amp, s), lane_s32);
+
+            if (filter->enabled) {
+                lane_s32 f;
+                if (ramped) {
+                    f_ramp += f_step;
+                    f = f_ramp >> 8;
+                } else {
+                    lane_svf_update(g, lane_cutoff(filter, lane_gather(g->filt, s), s), alive);
+                    f = g->f;
+                }
+
+                lane_s32 notch = sample - ((g->bp * g->damp) >> 15);
+                lane_s32 lp = lane_clip16(g->lp + ((f * g->bp) >> 15));
+                lane_s32 hp = notch - lp;
+                lane_s32 bp = lane_clip16(g->bp + ((f * hp) >> 15));
+                g->lp = alive ? lp : g->lp;
+                g->bp = alive ? bp : g->bp;
+                sample = bp;
+            }
+
+            g->alive = alive;
+
+            lane_f32 out = __builtin_convertvector(sample, lane_f32) * g->gain;
+            out = alive ? out : zero;
+            lane_f32 magnitude = out < zero ? -out : out;
+            g->peak = magnitude > g->peak ? magnitude : g->peak;
+            mix[s] += (out[0] + out[1]) + (out[2] + out[3]);
+        }
+        g->f = f_target;
+    }
+}
+
+/*
+ * Soft clip on full-scale units: the rational tanh approximant
+ * x (27 + x^2) / (27 + 9 x^2), which reaches +/-1 with zero slope at +/-3.
+ */
+static inline lane_f32 lane_soft_clip(lane_f32 x) {
+    const lane_f32 limit = lane_f32_set1(3.0f);
+    x = x > limit ? limit : x;
+    x = x < -limit ? -limit : x;
+    lane_f32 x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+/* Four frames of the output stage: volume, saturation, L/R pairs */
+static inline lane_u32 lane_output(lane_f32 x, lane_f32 volume, int clip) {
+    const lane_f32 hi = lane_f32_set1(32767.0f);
+    const lane_f32 lo = lane_f32_set1(-32768.0f);
+    x *= volume;
+    if (clip == VOICE_LANES_CLIP_SOFT) x = lane_soft_clip(x * (1.0f / 32768.0f)) * 32767.0f;
+    x = x > hi ? hi : x;
+    x = x < lo ? lo : x;
+    /* Each sample in both halves of its lane: one interleaved frame in memory */
+    lane_u32 q = (lane_u32)__builtin_convertvector(x, lane_s32);
+    return (q & 0xffff) | (q << 16);
+}
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "lane_output packs L/R little-endian");
+
+/*
+ * Write the mono bus mix (int16 units, before volume) to out as interleaved
+ * stereo int16: mix[s] * volume[s], saturated once, on both channels.
+ */
+static inline void voice_lanes_output(const float *mix, const float *volume, int clip,
+                                      int16_t *out, int frames) {
+    int s = 0;
+    for (; s + VOICE_LANE_WIDTH <= frames; s += VOICE_LANE_WIDTH) {
+        lane_f32 x, v;
+        memcpy(&x, mix + s, sizeof(x));
+        memcpy(&v, volume + s, sizeof(v));
+        lane_u32 frame = lane_output(x, v, clip);
+        memcpy(out + s * 2, &frame, sizeof(frame));
+    }
+    if (s < frames) {
+        /* Tail: the same pass on a zero-padded copy */
+        int n = frames - s;
+        lane_f32 x = lane_f32_set1(0.0f), v = lane_f32_set1(0.0f);
+        memcpy(&x, mix + s, n * sizeof(float));
+        memcpy(&v, volume + s, n * sizeof(float));
+        lane_u32 frame = lane_output(x, v, clip);
+        memcpy(out + s * 2, &frame, n * sizeof(uint32_t));
+    }
+}
+
+#endif /* VOICE_LANES_H */
@@ -0,0 +1,248 @@
+/*
+ * worker_pool.h - Small pinned worker pool for parallel voice rendering
+ *
+ * One pool per process, shared by every instance that enables threading.
+ * A batch is a count of independent jobs plus an optional finish callback;
+ * the submitting thread, the workers and (for pipelined rendering) nobody
+ * in particular claim job indices, highest first, from a single atomic
+ * counter, so distribution is lock-free and the caller can always help.
+ * Jobs must only write state owned by their index: that way results do not
+ * depend on which thread ran what, and a fixed-order mix afterwards is
+ * deterministic.
+ *
+ * Workers are pinned one per core (starting at core 1), spin briefly after
+ * each batch and then sleep on a futex; the submitter only pays for a wake-up
+ * syscall when a worker is actually asleep. On their first batch they adopt
+ * the submitting (audio) thread's scheduling policy and priority if allowed.
+ *
+ * Only one batch is in flight at a time. worker_pool_submit fails rather
+ * than waits when another instance's batch is still running, and the caller
+ * renders inline instead.
+ *
+ * Usage:
+ *   worker_pool_t *pool = worker_pool_acquire();   (control thread; NULL = 1 core)
+ *   uint32_t ticket;
+ *   if (worker_pool_submit(pool, job, NULL, ctx, count, &ticket) == 0)
+ *       worker_pool_wait(pool, ticket);             (helps, then waits)
+ *   else
+ *       for (i = 0; i < count; i++) job(ctx, i);
+ *   worker_pool_release(pool);
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define WORKER_POOL_MAX_THREADS 3   /* Move has 4 cores; the audio thread keeps one */
+#define WORKER_POOL_SPIN 20000      /* Polls before a worker sleeps (~tens of us) */
+
+typedef void (*worker_job_fn)(void *ctx, int index);
+typedef void (*worker_finish_fn)(void *ctx);
+
+typedef struct {
+    /* Current batch; written by the submitter before generation moves on */
+    worker_job_fn job;
+    worker_finish_fn finish;        /* Run by whoever completes the last job */
+    void *ctx;
+    uint32_t count;
+
+    /* Claim counter: generation << 32 | jobs left to claim */
+    uint64_t next __attribute__((aligned(64)));
+    uint32_t done __attribute__((aligned(64)));
+    uint32_t completed;             /* Generation of the last finished batch */
+
+    uint32_t generation __attribute__((aligned(64)));  /* Futex word */
+    uint32_t sleepers;
+    int busy;                       /* A batch is in flight */
+    int stop;
+
+    /* Scheduling the workers adopt, copied from the first submitter */
+    int sched_known;
+    int sched_policy;
+    int sched_priority;
+
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    int thread_count;
+    int refs;
+} worker_pool_t;
+
+static inline void worker_pool_relax(void) {
+#if defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause");
+#endif
+}
+
+static inline void worker_pool_futex(uint32_t *word, int op, uint32_t value) {
+    syscall(SYS_futex, word, op | FUTEX_PRIVATE_FLAG, value, NULL, NULL, 0);
+}
+
+/* Run the finish callback and hand the pool back */
+static inline void worker_pool_complete(worker_pool_t *pool, uint32_t gen) {
+    if (pool->finish) pool->finish(pool->ctx);
+    __atomic_store_n(&pool->completed, gen, __ATOMIC_RELEASE);
+    __atomic_store_n(&pool->busy, 0, __ATOMIC_RELEASE);
+}
+
+/* Claim and run jobs of batch gen until none are left */
+static inline void worker_pool_run(worker_pool_t *pool, uint32_t gen) {
+    for (;;) {
+        /* Counting down means a claim never reads count, which a straggler
+         * from the previous batch could otherwise see already rewritten */
+        uint64_t n = __atomic_load_n(&pool->next, __ATOMIC_ACQUIRE);
+        if ((uint32_t)(n >> 32) != gen || (uint32_t)n == 0) return;
+        if (!__atomic_compare_exchange_n(&pool->next, &n, n - 1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        /* The claim succeeded, so job/ctx/count belong to gen */
+        uint32_t count = pool->count;
+        pool->job(pool->ctx, (int)(uint32_t)n - 1);
+        if (__atomic_add_fetch(&pool->done, 1, __ATOMIC_ACQ_REL) == count) {
+            worker_pool_complete(pool, gen);
+        }
+    }
+}
+
+static void *worker_pool_thread(void *arg) {
+    worker_pool_t *pool = (worker_pool_t*)arg;
+    uint32_t seen = __atomic_load_n(&pool->generation, __ATOMIC_ACQUIRE);
+    int sched_applied = 0;
+
+    for (;;) {
+        /* stop is checked too: a thread may first run after the final bump */
+        uint32_t gen = seen;
+        for (int i = 0; i < WORKER_POOL_SPIN && gen == seen
+             && !__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE); i++) {
+            worker_pool_relax();
+            gen = __atomic_load_n(&pool->generation, __ATOMIC_ACQUIRE);
+        }
+        if (gen == seen) {
+            /* Pairs with the submitter's generation store / sleepers load */
+            __atomic_add_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+            while ((gen = __atomic_load_n(&pool->generation, __ATOMIC_SEQ_CST)) == seen
+                   && !__atomic_load_n(&pool->stop, __ATOMIC_SEQ_CST)) {
+                worker_pool_futex(&pool->generation, FUTEX_WAIT, seen);
+            }
+            __atomic_sub_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+        }
+        if (__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE)) break;
+        seen = gen;
+
+        if (!sched_applied && __atomic_load_n(&pool->sched_known, __ATOMIC_ACQUIRE)) {
+            struct sched_param sp;
+            memset(&sp, 0, sizeof(sp));
+            sp.sched_priority = pool->sched_priority;
+            pthread_setschedparam(pthread_self(), pool->sched_policy, &sp);  /* Best effort */
+            sched_applied = 1;
+        }
+        worker_pool_run(pool, gen);
+    }
+    return NULL;
+}
+
+/*
+ * Start a batch of count jobs. Returns: 0 with *ticket set, -1 if the pool
+ * is busy with another batch (run the jobs inline instead).
+ */
+static inline int worker_pool_submit(worker_pool_t *pool, worker_job_fn job,
+                                     worker_finish_fn finish, void *ctx, int count,
+                                     uint32_t *ticket) {
+    if (!pool || count <= 0) return -1;
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&pool->busy, &expected, 1, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return -1;
+    }
+    if (!pool->sched_known) {
+        struct sched_param sp;
+        if (pthread_getschedparam(pthread_self(), &pool->sched_policy, &sp) == 0) {
+            pool->sched_priority = sp.sched_priority;
+            __atomic_store_n(&pool->sched_known, 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    uint32_t gen = __atomic_load_n(&pool->generation, __ATOMIC_RELAXED) + 1;
+    pool->job = job;
+    pool->finish = finish;
+    pool->ctx = ctx;
+    pool->count = (uint32_t)count;
+    __atomic_store_n(&pool->done, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&pool->next, (uint64_t)gen << 32 | (uint32_t)count, __ATOMIC_RELEASE);
+    __atomic_store_n(&pool->generation, gen, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool->sleepers, __ATOMIC_SEQ_CST)) {
+        worker_pool_futex(&pool->generation, FUTEX_WAKE, WORKER_POOL_MAX_THREADS);
+    }
+    *ticket = gen;
+    return 0;
+}
+
+/* Whether batch ticket (and its finish callback) has completed */
+static inline int worker_pool_done(worker_pool_t *pool, uint32_t ticket) {
+    return (int32_t)(__atomic_load_n(&pool->completed, __ATOMIC_ACQUIRE) - ticket) >= 0;
+}
+
+/* Help with batch ticket, then wait for the jobs other threads claimed */
+static inline void worker_pool_wait(worker_pool_t *pool, uint32_t ticket) {
+    worker_pool_run(pool, ticket);
+    while (!worker_pool_done(pool, ticket)) worker_pool_relax();
+}
+
+static pthread_mutex_t g_worker_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static worker_pool_t g_worker_pool;
+
+/* Control thread: start (or share) the pool. Returns NULL on a single core. */
+static worker_pool_t *worker_pool_acquire(void) {
+    worker_pool_t *pool = &g_worker_pool;
+    pthread_mutex_lock(&g_worker_pool_lock);
+    if (pool->refs == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        int wanted = cores > 1 ? (int)(cores - 1) : 0;
+        if (wanted > WORKER_POOL_MAX_THREADS) wanted = WORKER_POOL_MAX_THREADS;
+
+        pool->stop = 0;
+        pool->thread_count = 0;
+        for (int i = 0; i < wanted; i++) {
+            if (pthread_create(&pool->threads[i], NULL, worker_pool_thread, pool) != 0) break;
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET((i + 1) % cores, &set);
+            pthread_setaffinity_np(pool->threads[i], sizeof(set), &set);  /* Best effort */
+#endif
+            pool->thread_count++;
+        }
+    }
+    if (pool->thread_count == 0) {
+        pthread_mutex_unlock(&g_worker_pool_lock);
+        return NULL;
+    }
+    pool->refs++;
+    pthread_mutex_unlock(&g_worker_pool_lock);
+    return pool;
+}
+
+/* Control thread: drop a reference; the last one stops the workers */
+static void worker_pool_release(worker_pool_t *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&g_worker_pool_lock);
+    if (--pool->refs == 0) {
+        while (__atomic_load_n(&pool->busy, __ATOMIC_ACQUIRE)) worker_pool_relax();
+        __atomic_store_n(&pool->stop, 1, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&pool->generation, 1, __ATOMIC_SEQ_CST);
+        worker_pool_futex(&pool->generation, FUTEX_WAKE, WORKER_POOL_MAX_THREADS);
+        for (int i = 0; i < pool->thread_count; i++) pthread_join(pool->threads[i], NULL);
+        pool->thread_count = 0;
+    }
+    pthread_mutex_unlock(&g_worker_pool_lock);
+}
+
+#endif /* WORKER_POOL_H */
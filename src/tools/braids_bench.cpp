@@ -0,0 +1,479 @@
+/*
+ * braids_bench - Host-less per-engine benchmark for the Braids plugin
+ *
+ * Links the same objects as dsp.so and drives the plugin exclusively
+ * through move_plugin_init_v2 with a stub host: for every engine and
+ * 1-N held voices (default 4, up to 16) it sweeps timbre/color/pitch,
+ * renders 128-frame blocks
+ * and reports mean and worst-case block time against the real-time budget
+ * (128 frames @ 44.1 kHz = ~2.9 ms).
+ *
+ * Usage:
+ *   braids_bench [--blocks N] [--warmup N] [--voices N] [--engine NAME|IDX]
+ *                [--filter] [--set KEY=VAL]... [--json FILE] [--quiet]
+ *                [--compare FILE]
+ *
+ * --set passes an extra set_param to every instance before rendering, e.g.
+ * --set render_mode=scalar to time the reference render path.
+ *
+ * The table goes to stdout; --json writes a machine-readable report so two
+ * builds can be diffed.
+ *
+ * Where the kernel allows it (perf_event_open, see perf_event_paranoid) each
+ * measured block also counts L1 data-cache read misses; otherwise the column
+ * shows n/a. --compare FILE reads another run's --json report and prints
+ * time and miss deltas per engine, e.g. for the table layouts:
+ *   ./build/braids_bench_stock --json stock.json
+ *   ./build/braids_bench --compare stock.json
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "plugin_api_v1.h"
+#include "braids/settings.h"
+
+extern "C" plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BENCH_DEFAULT_VOICES 4
+#define BENCH_MAX_VOICES 16
+#define BENCH_MAX_SETS 16
+#define BENCH_MAX_COMPARE 1024
+#define BENCH_NUM_SHAPES ((int)braids::MACRO_OSC_SHAPE_LAST_ACCESSIBLE_FROM_META + 1)
+
+/* Sweep points: each (timbre, color) pair is rendered at each base note */
+static const float g_sweep_params[][2] = {
+    { 0.1f, 0.1f },
+    { 0.5f, 0.5f },
+    { 0.9f, 0.9f },
+};
+static const int g_sweep_notes[] = { 36, 60, 84 };
+
+#define NUM_SWEEP_PARAMS ((int)(sizeof(g_sweep_params) / sizeof(g_sweep_params[0])))
+#define NUM_SWEEP_NOTES ((int)(sizeof(g_sweep_notes) / sizeof(g_sweep_notes[0])))
+
+/* Chord spread so that voices never share a note */
+static const int g_voice_offsets[BENCH_MAX_VOICES] = {
+    0, 7, 12, 16, 19, 24, 28, 31, 36, -5, -12, -8, 3, 10, 14, 21
+};
+
+struct BenchOptions {
+    int blocks;
+    int warmup;
+    int max_voices;
+    int engine;         /* -1 = all */
+    int filter;
+    int quiet;
+    const char *json_path;
+    const char *compare_path;
+    int set_count;
+    char set_keys[BENCH_MAX_SETS][64];
+    const char *set_vals[BENCH_MAX_SETS];
+};
+
+struct BenchResult {
+    char engine[16];
+    int index;
+    int voices;
+    double mean_ns;
+    double worst_ns;
+    double l1d_misses;  /* Per block; < 0 if not counted */
+};
+
+static int g_verbose_log = 0;
+
+static void bench_log(const char *msg) {
+    if (g_verbose_log) fprintf(stderr, "%s\n", msg);
+}
+
+static host_api_v1_t g_stub_host;
+static int g_l1d_fd = -1;
+
+/* L1D read-miss counter for this thread, user space only. -1 if the kernel
+ * or CPU doesn't provide it. */
+static int open_l1d_counter(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_L1D |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t read_counter(int fd) {
+    uint64_t value = 0;
+    if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) value = 0;
+    return value;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void send_note(plugin_api_v2_t *api, void *inst, int on, int note) {
+    uint8_t msg[3];
+    msg[0] = on ? 0x90 : 0x80;
+    msg[1] = (uint8_t)note;
+    msg[2] = on ? 100 : 0;
+    api->on_midi(inst, msg, 3, MOVE_MIDI_SOURCE_INTERNAL);
+}
+
+static void set_float(plugin_api_v2_t *api, void *inst, const char *key, float v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.4f", v);
+    api->set_param(inst, key, buf);
+}
+
+/* Benchmark one engine at a given voice count across the whole sweep */
+static void bench_point(plugin_api_v2_t *api, const BenchOptions *opt,
+                        int engine, int voices, BenchResult *out) {
+    int16_t block[MOVE_FRAMES_PER_BLOCK * 2];
+    uint64_t total_ns = 0;
+    uint64_t worst_ns = 0;
+    uint64_t misses = 0;
+    long measured = 0;
+
+    void *inst = api->create_instance("/nonexistent", NULL);
+    if (!inst) {
+        fprintf(stderr, "create_instance failed\n");
+        exit(1);
+    }
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%d", engine);
+    api->set_param(inst, "engine", buf);
+    api->get_param(inst, "engine", out->engine, sizeof(out->engine));
+    out->index = engine;
+    out->voices = voices;
+
+    /* Fixed polyphony: the plugin's CPU-budget voice ceiling would steal */
+    api->set_param(inst, "voice_budget", "0");
+    snprintf(buf, sizeof(buf), "%d", BENCH_MAX_VOICES);
+    api->set_param(inst, "max_voices", buf);
+
+    for (int i = 0; i < opt->set_count; i++) {
+        api->set_param(inst, opt->set_keys[i], opt->set_vals[i]);
+    }
+
+    /* Held notes: instant attack, full sustain */
+    set_float(api, inst, "attack", 0.0f);
+    set_float(api, inst, "sustain", 1.0f);
+    set_float(api, inst, "release", 0.0f);
+    if (opt->filter) {
+        set_float(api, inst, "cutoff", 0.4f);
+        set_float(api, inst, "resonance", 0.3f);
+        set_float(api, inst, "filt_env", 0.5f);
+        set_float(api, inst, "f_sustain", 0.5f);
+    }
+
+    for (int p = 0; p < NUM_SWEEP_PARAMS; p++) {
+        set_float(api, inst, "timbre", g_sweep_params[p][0]);
+        set_float(api, inst, "color", g_sweep_params[p][1]);
+
+        for (int n = 0; n < NUM_SWEEP_NOTES; n++) {
+            for (int v = 0; v < voices; v++) {
+                send_note(api, inst, 1, g_sweep_notes[n] + g_voice_offsets[v]);
+            }
+            for (int b = 0; b < opt->warmup; b++) {
+                api->render_block(inst, block, MOVE_FRAMES_PER_BLOCK);
+            }
+            for (int b = 0; b < opt->blocks; b++) {
+                /* Counter control stays outside the timed region */
+                if (g_l1d_fd >= 0) {
+                    ioctl(g_l1d_fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(g_l1d_fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+                uint64_t t0 = now_ns();
+                api->render_block(inst, block, MOVE_FRAMES_PER_BLOCK);
+                uint64_t dt = now_ns() - t0;
+                if (g_l1d_fd >= 0) {
+                    ioctl(g_l1d_fd, PERF_EVENT_IOC_DISABLE, 0);
+                    misses += read_counter(g_l1d_fd);
+                }
+                total_ns += dt;
+                if (dt > worst_ns) worst_ns = dt;
+                measured++;
+            }
+            for (int v = 0; v < voices; v++) {
+                send_note(api, inst, 0, g_sweep_notes[n] + g_voice_offsets[v]);
+            }
+            /* Let the (zero-length) release finish before the next point */
+            for (int b = 0; b < 4; b++) {
+                api->render_block(inst, block, MOVE_FRAMES_PER_BLOCK);
+            }
+        }
+    }
+
+    api->destroy_instance(inst);
+
+    out->mean_ns = measured ? (double)total_ns / (double)measured : 0.0;
+    out->worst_ns = (double)worst_ns;
+    out->l1d_misses = (g_l1d_fd >= 0 && measured)
+        ? (double)misses / (double)measured : -1.0;
+}
+
+static int parse_engine(plugin_api_v2_t *api, const char *arg) {
+    char *end;
+    long idx = strtol(arg, &end, 10);
+    if (*arg && *end == '\0') {
+        return (idx >= 0 && idx < BENCH_NUM_SHAPES) ? (int)idx : -2;
+    }
+    /* Resolve by name through the plugin itself */
+    void *inst = api->create_instance("/nonexistent", NULL);
+    int found = -2;
+    for (int i = 0; i < BENCH_NUM_SHAPES && inst; i++) {
+        char buf[32], name[16];
+        snprintf(buf, sizeof(buf), "%d", i);
+        api->set_param(inst, "engine", buf);
+        api->get_param(inst, "engine", name, sizeof(name));
+        if (strcmp(name, arg) == 0) { found = i; break; }
+    }
+    if (inst) api->destroy_instance(inst);
+    return found;
+}
+
+static void write_json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '\\' || *s == '"') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static int write_json(const char *path, const BenchOptions *opt,
+                      const BenchResult *results, int count, double budget_ns) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return -1;
+    }
+    fprintf(f, "{\n");
+    fprintf(f, "  \"sample_rate\": %d,\n", MOVE_SAMPLE_RATE);
+    fprintf(f, "  \"frames_per_block\": %d,\n", MOVE_FRAMES_PER_BLOCK);
+    fprintf(f, "  \"budget_ns\": %.0f,\n", budget_ns);
+    fprintf(f, "  \"blocks_per_point\": %d,\n", opt->blocks);
+    fprintf(f, "  \"sweep_points\": %d,\n", NUM_SWEEP_PARAMS * NUM_SWEEP_NOTES);
+    fprintf(f, "  \"filter\": %s,\n", opt->filter ? "true" : "false");
+    fprintf(f, "  \"results\": [\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(f, "    {\"engine\": ");
+        write_json_string(f, r->engine);
+        fprintf(f, ", \"index\": %d, \"voices\": %d, \"mean_ns\": %.0f, "
+                   "\"worst_ns\": %.0f, \"mean_pct\": %.2f, \"worst_pct\": %.2f, ",
+                r->index, r->voices, r->mean_ns, r->worst_ns,
+                100.0 * r->mean_ns / budget_ns, 100.0 * r->worst_ns / budget_ns);
+        if (r->l1d_misses >= 0.0) {
+            fprintf(f, "\"l1d_misses_per_block\": %.1f}", r->l1d_misses);
+        } else {
+            fprintf(f, "\"l1d_misses_per_block\": null}");
+        }
+        fprintf(f, "%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return 0;
+}
+
+/* Reads the results of a --json report written by this tool (one result object
+ * per line). Returns: number of results, or -1 if the file can't be read */
+static int read_json(const char *path, BenchResult *results, int capacity) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char line[512];
+    int count = 0;
+    while (count < capacity && fgets(line, sizeof(line), f)) {
+        BenchResult *r = &results[count];
+        if (sscanf(line, " {\"engine\": \"%15[^\"]\", \"index\": %d, \"voices\": %d, "
+                         "\"mean_ns\": %lf, \"worst_ns\": %lf",
+                   r->engine, &r->index, &r->voices, &r->mean_ns, &r->worst_ns) != 5) {
+            continue;
+        }
+        const char *m = strstr(line, "\"l1d_misses_per_block\": ");
+        r->l1d_misses = -1.0;
+        if (m) sscanf(m + strlen("\"l1d_misses_per_block\": "), "%lf", &r->l1d_misses);
+        count++;
+    }
+    fclose(f);
+    return count;
+}
+
+static void format_misses(char *buf, size_t size, double misses) {
+    if (misses >= 0.0) snprintf(buf, size, "%.1f", misses);
+    else snprintf(buf, size, "n/a");
+}
+
+/* Per-engine time and L1D-miss deltas against a baseline report */
+static void print_compare(const BenchResult *results, int count,
+                          const BenchResult *base, int base_count) {
+    printf("\n%-8s %3s %12s %12s %8s %12s %12s\n",
+           "ENGINE", "V", "mean ns", "base ns", "delta %", "L1D miss", "base miss");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        const BenchResult *b = NULL;
+        for (int j = 0; j < base_count && !b; j++) {
+            if (base[j].index == r->index && base[j].voices == r->voices) b = &base[j];
+        }
+        if (!b) continue;
+        char miss[24], base_miss[24];
+        format_misses(miss, sizeof(miss), r->l1d_misses);
+        format_misses(base_miss, sizeof(base_miss), b->l1d_misses);
+        printf("%-8s %3d %12.0f %12.0f %+7.2f%% %12s %12s\n",
+               r->engine, r->voices, r->mean_ns, b->mean_ns,
+               b->mean_ns > 0.0 ? 100.0 * (r->mean_ns - b->mean_ns) / b->mean_ns : 0.0,
+               miss, base_miss);
+    }
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+        "Usage: %s [--blocks N] [--warmup N] [--voices N] [--engine NAME|IDX]\n"
+        "          [--filter] [--set KEY=VAL]... [--json FILE] [--quiet] [--verbose]\n"
+        "          [--compare FILE]\n",
+        argv0);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions opt;
+    opt.blocks = 64;
+    opt.warmup = 8;
+    opt.max_voices = BENCH_DEFAULT_VOICES;
+    opt.engine = -1;
+    opt.filter = 0;
+    opt.quiet = 0;
+    opt.json_path = NULL;
+    opt.compare_path = NULL;
+    opt.set_count = 0;
+    const char *engine_arg = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        int has_value = (i + 1 < argc);
+        if (strcmp(a, "--blocks") == 0 && has_value) {
+            opt.blocks = atoi(argv[++i]);
+        } else if (strcmp(a, "--warmup") == 0 && has_value) {
+            opt.warmup = atoi(argv[++i]);
+        } else if (strcmp(a, "--voices") == 0 && has_value) {
+            opt.max_voices = atoi(argv[++i]);
+        } else if (strcmp(a, "--engine") == 0 && has_value) {
+            engine_arg = argv[++i];
+        } else if (strcmp(a, "--json") == 0 && has_value) {
+            opt.json_path = argv[++i];
+        } else if (strcmp(a, "--compare") == 0 && has_value) {
+            opt.compare_path = argv[++i];
+        } else if (strcmp(a, "--set") == 0 && has_value) {
+            const char *kv = argv[++i];
+            const char *eq = strchr(kv, '=');
+            if (!eq || eq == kv || (size_t)(eq - kv) >= sizeof(opt.set_keys[0])
+                || opt.set_count >= BENCH_MAX_SETS) {
+                usage(argv[0]);
+                return 2;
+            }
+            memcpy(opt.set_keys[opt.set_count], kv, eq - kv);
+            opt.set_keys[opt.set_count][eq - kv] = '\0';
+            opt.set_vals[opt.set_count] = eq + 1;
+            opt.set_count++;
+        } else if (strcmp(a, "--filter") == 0) {
+            opt.filter = 1;
+        } else if (strcmp(a, "--quiet") == 0) {
+            opt.quiet = 1;
+        } else if (strcmp(a, "--verbose") == 0) {
+            g_verbose_log = 1;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (opt.blocks < 1) opt.blocks = 1;
+    if (opt.warmup < 0) opt.warmup = 0;
+    if (opt.max_voices < 1) opt.max_voices = 1;
+    if (opt.max_voices > BENCH_MAX_VOICES) opt.max_voices = BENCH_MAX_VOICES;
+
+    memset(&g_stub_host, 0, sizeof(g_stub_host));
+    g_stub_host.api_version = MOVE_PLUGIN_API_VERSION;
+    g_stub_host.sample_rate = MOVE_SAMPLE_RATE;
+    g_stub_host.frames_per_block = MOVE_FRAMES_PER_BLOCK;
+    g_stub_host.log = bench_log;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&g_stub_host);
+    if (!api || api->api_version != MOVE_PLUGIN_API_VERSION_2) {
+        fprintf(stderr, "move_plugin_init_v2 failed\n");
+        return 1;
+    }
+
+    if (engine_arg) {
+        opt.engine = parse_engine(api, engine_arg);
+        if (opt.engine < 0) {
+            fprintf(stderr, "Unknown engine: %s\n", engine_arg);
+            return 2;
+        }
+    }
+
+    double budget_ns = 1e9 * MOVE_FRAMES_PER_BLOCK / (double)MOVE_SAMPLE_RATE;
+    int first = opt.engine >= 0 ? opt.engine : 0;
+    int last = opt.engine >= 0 ? opt.engine : BENCH_NUM_SHAPES - 1;
+    int capacity = (last - first + 1) * opt.max_voices;
+    BenchResult *results = (BenchResult*)calloc(capacity, sizeof(BenchResult));
+    if (!results) return 1;
+
+    BenchResult *base = NULL;
+    int base_count = 0;
+    if (opt.compare_path) {
+        base = (BenchResult*)calloc(BENCH_MAX_COMPARE, sizeof(BenchResult));
+        if (!base) return 1;
+        base_count = read_json(opt.compare_path, base, BENCH_MAX_COMPARE);
+        if (base_count < 0) {
+            fprintf(stderr, "Cannot read %s\n", opt.compare_path);
+            return 1;
+        }
+    }
+
+    g_l1d_fd = open_l1d_counter();
+
+    if (!opt.quiet) {
+        printf("%-8s %3s %12s %12s %8s %8s %12s\n",
+               "ENGINE", "V", "mean ns", "worst ns", "mean %", "worst %", "L1D miss");
+    }
+
+    int count = 0;
+    for (int e = first; e <= last; e++) {
+        for (int v = 1; v <= opt.max_voices; v++) {
+            BenchResult *r = &results[count++];
+            bench_point(api, &opt, e, v, r);
+            if (!opt.quiet) {
+                char miss[24];
+                format_misses(miss, sizeof(miss), r->l1d_misses);
+                printf("%-8s %3d %12.0f %12.0f %7.2f%% %7.2f%% %12s\n",
+                       r->engine, r->voices, r->mean_ns, r->worst_ns,
+                       100.0 * r->mean_ns / budget_ns, 100.0 * r->worst_ns / budget_ns,
+                       miss);
+                fflush(stdout);
+            }
+        }
+    }
+
+    if (base) print_compare(results, count, base, base_count);
+
+    int rc = 0;
+    if (opt.json_path) {
+        rc = write_json(opt.json_path, &opt, results, count, budget_ns) == 0 ? 0 : 1;
+    }
+    if (g_l1d_fd >= 0) close(g_l1d_fd);
+    free(base);
+    free(results);
+    return rc;
+}
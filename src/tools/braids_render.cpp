@@ -0,0 +1,688 @@
+/*
+ * braids_render - Offline MIDI file to WAV renderer for the Braids plugin
+ *
+ * Links the same objects as dsp.so and drives the plugin through
+ * move_plugin_init_v2 with a stub host, like braids_bench. Each preset of
+ * <module>/presets (loaded by the plugin itself at create_instance) plays a
+ * Standard MIDI File (format 0 or 1) through on_midi / render_block, as
+ * fast as the CPU allows, into a 16-bit stereo WAV at 44.1 kHz. Presets
+ * render in parallel, one instance per preset, on --jobs threads.
+ *
+ * Every output gets a 64-bit FNV-1a checksum of its PCM data, printed as
+ *   <checksum>  <wav name>
+ * so a run redirected to a file is a golden reference for --verify: the
+ * renders are deterministic (fixed polyphony, no wall-clock MIDI timing),
+ * and any DSP change that alters the output shows up as a mismatch.
+ *
+ * Usage:
+ *   braids_render [--module DIR] [--preset NAME|IDX|all]... [--out PATH]
+ *                 [--jobs N] [--tail SECONDS] [--preroll BLOCKS]
+ *                 [--timing sample|block] [--set KEY=VAL]... [--no-wav]
+ *                 [--verify FILE] [--verbose] song.mid
+ *
+ * --out is a directory (default .) that gets <song>-<preset>.wav files, or
+ * a .wav path when a single preset is rendered. --timing sample (default)
+ * cuts render_block calls short at each event so notes land on their own
+ * sample; block delivers the events of a 128-frame block before it, as the
+ * Move host does. Before the song, --preroll blocks (default 32) of silence
+ * let parameter smoothing settle on the preset's values; they are not
+ * written. --set passes an extra set_param after the preset is selected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "plugin_api_v1.h"
+
+extern "C" plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define RENDER_MAX_PRESETS 256
+#define RENDER_MAX_SETS 16
+#define RENDER_MAX_JOBS 16
+#define RENDER_DEFAULT_PREROLL 32
+#define RENDER_DEFAULT_TAIL 2.0
+#define RENDER_MAX_FILE (16 * 1024 * 1024)
+#define RENDER_DEFAULT_TEMPO 500000     /* us per quarter note: 120 BPM */
+
+/* One channel message at its position in the song */
+struct SongEvent {
+    uint64_t tick;
+    uint64_t frame;
+    uint32_t order;     /* Track-major file order, keeps the sort stable */
+    uint32_t tempo;     /* Set tempo meta events: us per quarter; 0 otherwise */
+    uint8_t msg[3];
+    int len;
+};
+
+struct Song {
+    SongEvent *events;
+    int count;
+    int capacity;
+    uint64_t frames;    /* Frame of the last event */
+};
+
+struct RenderOptions {
+    const char *module_dir;
+    const char *out_path;
+    const char *verify_path;
+    int jobs;
+    int preroll;
+    int sample_timing;
+    int write_wav;
+    double tail;
+    int set_count;
+    char set_keys[RENDER_MAX_SETS][64];
+    const char *set_vals[RENDER_MAX_SETS];
+};
+
+struct RenderJob {
+    int preset;
+    char preset_name[64];
+    char wav_name[256];
+    char wav_path[768];
+    uint64_t checksum;
+    uint64_t frames;
+    int failed;
+};
+
+static int g_verbose_log = 0;
+static host_api_v1_t g_stub_host;
+static plugin_api_v2_t *g_api;
+static const RenderOptions *g_opt;
+static const Song *g_song;
+static RenderJob *g_jobs;
+static int g_job_count;
+static int g_next_job;
+
+static void render_log(const char *msg) {
+    if (g_verbose_log) fprintf(stderr, "%s\n", msg);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* =====================================================================
+ * Standard MIDI File parsing
+ * ===================================================================== */
+
+static uint32_t read_be(const uint8_t *p, int bytes) {
+    uint32_t v = 0;
+    for (int i = 0; i < bytes; i++) v = v << 8 | p[i];
+    return v;
+}
+
+/* Variable-length quantity at *p (before end). Returns: 0, or -1 if truncated */
+static int read_vlq(const uint8_t **p, const uint8_t *end, uint32_t *value) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        if (*p >= end) return -1;
+        uint8_t b = *(*p)++;
+        v = v << 7 | (b & 0x7f);
+        if (!(b & 0x80)) {
+            *value = v;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int song_add(Song *song, uint64_t tick, uint32_t order, uint32_t tempo,
+                    const uint8_t *msg, int len) {
+    if (song->count == song->capacity) {
+        int capacity = song->capacity ? song->capacity * 2 : 1024;
+        SongEvent *grown = (SongEvent*)realloc(song->events, capacity * sizeof(SongEvent));
+        if (!grown) return -1;
+        song->events = grown;
+        song->capacity = capacity;
+    }
+    SongEvent *e = &song->events[song->count++];
+    memset(e, 0, sizeof(*e));
+    e->tick = tick;
+    e->order = order;
+    e->tempo = tempo;
+    if (len > 0) memcpy(e->msg, msg, len);
+    e->len = len;
+    return 0;
+}
+
+/* Channel messages and tempo changes of one MTrk chunk */
+static int parse_track(Song *song, const uint8_t *p, const uint8_t *end, uint32_t *order) {
+    uint64_t tick = 0;
+    uint8_t running = 0;
+    while (p < end) {
+        uint32_t delta;
+        if (read_vlq(&p, end, &delta) < 0 || p >= end) return -1;
+        tick += delta;
+
+        uint8_t status = *p;
+        if (status & 0x80) {
+            p++;
+        } else if (running) {
+            status = running;   /* Running status: p is at the first data byte */
+        } else {
+            return -1;
+        }
+
+        if (status == 0xff) {
+            if (p >= end) return -1;
+            uint8_t type = *p++;
+            uint32_t length;
+            if (read_vlq(&p, end, &length) < 0 || length > (uint32_t)(end - p)) return -1;
+            if (type == 0x2f) return 0;     /* End of track */
+            if (type == 0x51 && length == 3) {
+                if (song_add(song, tick, (*order)++, read_be(p, 3), NULL, 0) < 0) return -1;
+            }
+            p += length;
+            running = 0;
+        } else if (status == 0xf0 || status == 0xf7) {
+            uint32_t length;
+            if (read_vlq(&p, end, &length) < 0 || length > (uint32_t)(end - p)) return -1;
+            p += length;    /* SysEx: the plugin has no use for it */
+            running = 0;
+        } else if (status >= 0x80 && status < 0xf0) {
+            int len = (status & 0xf0) == 0xc0 || (status & 0xf0) == 0xd0 ? 2 : 3;
+            if (end - p < len - 1) return -1;
+            uint8_t msg[3] = { status, p[0], (uint8_t)(len > 2 ? p[1] : 0) };
+            p += len - 1;
+            running = status;
+            if (song_add(song, tick, (*order)++, 0, msg, len) < 0) return -1;
+        } else {
+            return -1;      /* System common messages do not occur in files */
+        }
+    }
+    return 0;
+}
+
+static int event_cmp(const void *a, const void *b) {
+    const SongEvent *x = (const SongEvent*)a;
+    const SongEvent *y = (const SongEvent*)b;
+    if (x->tick != y->tick) return x->tick < y->tick ? -1 : 1;
+    return x->order < y->order ? -1 : x->order > y->order;
+}
+
+/* Merge the tracks in time order and map ticks to frames through the tempo map */
+static void song_schedule(Song *song, uint16_t division) {
+    qsort(song->events, song->count, sizeof(SongEvent), event_cmp);
+
+    double seconds_per_tick;
+    uint32_t tempo = RENDER_DEFAULT_TEMPO;
+    int smpte = (division & 0x8000) != 0;
+    if (smpte) {
+        int fps = -(int8_t)(division >> 8);
+        seconds_per_tick = 1.0 / ((fps == 29 ? 29.97 : fps) * (division & 0xff));
+    } else {
+        seconds_per_tick = tempo * 1e-6 / (division ? division : 1);
+    }
+
+    double seconds = 0.0;
+    uint64_t tick = 0;
+    for (int i = 0; i < song->count; i++) {
+        SongEvent *e = &song->events[i];
+        seconds += (double)(e->tick - tick) * seconds_per_tick;
+        tick = e->tick;
+        e->frame = (uint64_t)(seconds * MOVE_SAMPLE_RATE + 0.5);
+        if (e->tempo && !smpte) {
+            seconds_per_tick = e->tempo * 1e-6 / (division ? division : 1);
+        }
+    }
+    song->frames = song->count ? song->events[song->count - 1].frame : 0;
+}
+
+/* Returns: 0, or -1 with a message on stderr */
+static int load_song(Song *song, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 14 || size > RENDER_MAX_FILE) {
+        fclose(f);
+        fprintf(stderr, "%s: not a MIDI file\n", path);
+        return -1;
+    }
+    uint8_t *data = (uint8_t*)malloc(size);
+    if (!data || fread(data, 1, size, f) != (size_t)size) {
+        fclose(f);
+        free(data);
+        fprintf(stderr, "Cannot read %s\n", path);
+        return -1;
+    }
+    fclose(f);
+
+    memset(song, 0, sizeof(*song));
+    const uint8_t *end = data + size;
+    if (memcmp(data, "MThd", 4) != 0 || read_be(data + 4, 4) < 6) {
+        free(data);
+        fprintf(stderr, "%s: not a MIDI file\n", path);
+        return -1;
+    }
+    uint16_t format = (uint16_t)read_be(data + 8, 2);
+    uint16_t division = (uint16_t)read_be(data + 12, 2);
+    if (format > 1) {
+        free(data);
+        fprintf(stderr, "%s: format %d files are not supported\n", path, format);
+        return -1;
+    }
+
+    const uint8_t *p = data + 8 + read_be(data + 4, 4);
+    uint32_t order = 0;
+    int rc = 0;
+    while (rc == 0 && end - p >= 8) {
+        uint32_t length = read_be(p + 4, 4);
+        const uint8_t *body = p + 8;
+        if (length > (uint32_t)(end - body)) {
+            rc = -1;
+            break;
+        }
+        if (memcmp(p, "MTrk", 4) == 0) rc = parse_track(song, body, body + length, &order);
+        p = body + length;
+    }
+    free(data);
+    if (rc < 0) {
+        fprintf(stderr, "%s: malformed track data\n", path);
+        free(song->events);
+        return -1;
+    }
+    song_schedule(song, division);
+    return 0;
+}
+
+/* =====================================================================
+ * Rendering
+ * ===================================================================== */
+
+static uint64_t fnv1a(uint64_t hash, const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static void put_le(uint8_t *p, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static int write_wav(const char *path, const int16_t *pcm, uint64_t frames) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return -1;
+    uint32_t data_size = (uint32_t)(frames * 4);
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    put_le(header + 4, 36 + data_size, 4);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    put_le(header + 16, 16, 4);
+    put_le(header + 20, 1, 2);                      /* PCM */
+    put_le(header + 22, 2, 2);                      /* Stereo */
+    put_le(header + 24, MOVE_SAMPLE_RATE, 4);
+    put_le(header + 28, MOVE_SAMPLE_RATE * 4, 4);    /* Bytes per second */
+    put_le(header + 32, 4, 2);                      /* Bytes per frame */
+    put_le(header + 34, 16, 2);
+    memcpy(header + 36, "data", 4);
+    put_le(header + 40, data_size, 4);
+    /* The plugin writes native int16; the tool only builds for little-endian */
+    int ok = fwrite(header, 1, sizeof(header), f) == sizeof(header)
+          && fwrite(pcm, 4, frames, f) == frames;
+    return fclose(f) == 0 && ok ? 0 : -1;
+}
+
+/* New instance on preset index preset, with the options' overrides */
+static void *open_instance(int preset) {
+    void *inst = g_api->create_instance(g_opt->module_dir, NULL);
+    if (!inst) return NULL;
+    /* Fixed polyphony: the plugin's CPU-budget voice ceiling depends on timing */
+    g_api->set_param(inst, "voice_budget", "0");
+    g_api->set_param(inst, "max_voices", "16");
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%d", preset);
+    g_api->set_param(inst, "preset", buf);
+    for (int i = 0; i < g_opt->set_count; i++) {
+        g_api->set_param(inst, g_opt->set_keys[i], g_opt->set_vals[i]);
+    }
+    return inst;
+}
+
+static void render_job(RenderJob *job) {
+    const Song *song = g_song;
+    uint64_t total = song->frames + (uint64_t)(g_opt->tail * MOVE_SAMPLE_RATE);
+    int16_t *pcm = (int16_t*)calloc(total ? total : 1, 4);
+    void *inst = open_instance(job->preset);
+    if (!pcm || !inst) {
+        if (inst) g_api->destroy_instance(inst);
+        free(pcm);
+        job->failed = 1;
+        return;
+    }
+
+    int16_t block[MOVE_FRAMES_PER_BLOCK * 2];
+    for (int b = 0; b < g_opt->preroll; b++) {
+        g_api->render_block(inst, block, MOVE_FRAMES_PER_BLOCK);
+    }
+
+    int ev = 0;
+    for (uint64_t pos = 0; pos < total; ) {
+        uint64_t end = pos + MOVE_FRAMES_PER_BLOCK;
+        if (end > total) end = total;
+        /* Block timing hands over everything due before the block ends */
+        uint64_t due = g_opt->sample_timing ? pos : end - 1;
+        for (; ev < song->count && song->events[ev].frame <= due; ev++) {
+            const SongEvent *e = &song->events[ev];
+            if (e->len) g_api->on_midi(inst, e->msg, e->len, MOVE_MIDI_SOURCE_EXTERNAL);
+        }
+        if (g_opt->sample_timing && ev < song->count && song->events[ev].frame < end) {
+            end = song->events[ev].frame;
+        }
+        g_api->render_block(inst, pcm + pos * 2, (int)(end - pos));
+        pos = end;
+    }
+    if (g_verbose_log) {
+        /* Blocking calls on the audio path (counted in BRAIDS_RT_WATCHDOG builds) */
+        char watchdog[256];
+        if (g_api->get_param(inst, "rt_watchdog", watchdog, sizeof(watchdog)) > 0) {
+            fprintf(stderr, "%s: rt_watchdog %s\n", job->wav_name, watchdog);
+        }
+    }
+    g_api->destroy_instance(inst);
+
+    job->frames = total;
+    job->checksum = fnv1a(0xcbf29ce484222325ull, (const uint8_t*)pcm, total * 4);
+    if (g_opt->write_wav && write_wav(job->wav_path, pcm, total) < 0) {
+        fprintf(stderr, "Cannot write %s\n", job->wav_path);
+        job->failed = 1;
+    }
+    free(pcm);
+}
+
+static void *render_thread(void *arg) {
+    (void)arg;
+    for (;;) {
+        int i = __atomic_fetch_add(&g_next_job, 1, __ATOMIC_RELAXED);
+        if (i >= g_job_count) return NULL;
+        render_job(&g_jobs[i]);
+    }
+}
+
+/* =====================================================================
+ * Command line
+ * ===================================================================== */
+
+/* Preset index for a name or number, -1 for "all", -2 if unknown */
+static int parse_preset(void *probe, int count, const char *arg) {
+    if (strcmp(arg, "all") == 0) return -1;
+    char *end;
+    long idx = strtol(arg, &end, 10);
+    if (*arg && *end == '\0') return (idx >= 0 && idx < count) ? (int)idx : -2;
+    for (int i = 0; i < count; i++) {
+        char buf[16], name[64];
+        snprintf(buf, sizeof(buf), "%d", i);
+        g_api->set_param(probe, "preset", buf);
+        g_api->get_param(probe, "preset_name", name, sizeof(name));
+        if (strcmp(name, arg) == 0) return i;
+    }
+    return -2;
+}
+
+static void file_stem(char *out, size_t size, const char *path) {
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    snprintf(out, size, "%s", base);
+    char *dot = strrchr(out, '.');
+    if (dot && dot != out) *dot = '\0';
+}
+
+/* Letters, digits, '-' and '_' only, so names work unquoted in a shell */
+static void sanitize(char *s) {
+    for (; *s; s++) {
+        char c = *s;
+        int ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+              || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        if (!ok) *s = '_';
+    }
+}
+
+static int ends_with(const char *s, const char *suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+/* Checks the jobs against a file of "<checksum>  <wav name>" lines.
+ * Returns: number of mismatches (missing references count), -1 if unreadable */
+static int verify(const char *path, const RenderJob *jobs, int count) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char line[512];
+    int matched[RENDER_MAX_PRESETS];
+    memset(matched, 0, sizeof(matched));
+    int failures = 0;
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long long sum;
+        char name[256];
+        if (sscanf(line, "%16llx %255s", &sum, name) != 2) continue;
+        for (int i = 0; i < count; i++) {
+            if (strcmp(jobs[i].wav_name, name) != 0) continue;
+            matched[i] = 1;
+            if (jobs[i].checksum != (uint64_t)sum) {
+                fprintf(stderr, "MISMATCH %s: %016llx, expected %016llx\n", name,
+                        (unsigned long long)jobs[i].checksum, sum);
+                failures++;
+            }
+        }
+    }
+    fclose(f);
+    for (int i = 0; i < count; i++) {
+        if (!matched[i]) {
+            fprintf(stderr, "MISSING %s: no reference checksum\n", jobs[i].wav_name);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+        "Usage: %s [--module DIR] [--preset NAME|IDX|all]... [--out PATH]\n"
+        "          [--jobs N] [--tail SECONDS] [--preroll BLOCKS]\n"
+        "          [--timing sample|block] [--set KEY=VAL]... [--no-wav]\n"
+        "          [--verify FILE] [--verbose] song.mid\n",
+        argv0);
+}
+
+int main(int argc, char **argv) {
+    RenderOptions opt;
+    memset(&opt, 0, sizeof(opt));
+    opt.module_dir = "src";
+    opt.out_path = ".";
+    opt.jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    opt.preroll = RENDER_DEFAULT_PREROLL;
+    opt.sample_timing = 1;
+    opt.write_wav = 1;
+    opt.tail = RENDER_DEFAULT_TAIL;
+    const char *preset_args[RENDER_MAX_PRESETS];
+    int preset_arg_count = 0;
+    const char *song_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        int has_value = (i + 1 < argc);
+        if (strcmp(a, "--module") == 0 && has_value) {
+            opt.module_dir = argv[++i];
+        } else if (strcmp(a, "--preset") == 0 && has_value
+                   && preset_arg_count < RENDER_MAX_PRESETS) {
+            preset_args[preset_arg_count++] = argv[++i];
+        } else if (strcmp(a, "--out") == 0 && has_value) {
+            opt.out_path = argv[++i];
+        } else if (strcmp(a, "--jobs") == 0 && has_value) {
+            opt.jobs = atoi(argv[++i]);
+        } else if (strcmp(a, "--tail") == 0 && has_value) {
+            opt.tail = atof(argv[++i]);
+        } else if (strcmp(a, "--preroll") == 0 && has_value) {
+            opt.preroll = atoi(argv[++i]);
+        } else if (strcmp(a, "--timing") == 0 && has_value) {
+            const char *t = argv[++i];
+            if (strcmp(t, "sample") == 0) opt.sample_timing = 1;
+            else if (strcmp(t, "block") == 0) opt.sample_timing = 0;
+            else { usage(argv[0]); return 2; }
+        } else if (strcmp(a, "--set") == 0 && has_value) {
+            const char *kv = argv[++i];
+            const char *eq = strchr(kv, '=');
+            if (!eq || eq == kv || (size_t)(eq - kv) >= sizeof(opt.set_keys[0])
+                || opt.set_count >= RENDER_MAX_SETS) {
+                usage(argv[0]);
+                return 2;
+            }
+            memcpy(opt.set_keys[opt.set_count], kv, eq - kv);
+            opt.set_keys[opt.set_count][eq - kv] = '\0';
+            opt.set_vals[opt.set_count] = eq + 1;
+            opt.set_count++;
+        } else if (strcmp(a, "--verify") == 0 && has_value) {
+            opt.verify_path = argv[++i];
+        } else if (strcmp(a, "--no-wav") == 0) {
+            opt.write_wav = 0;
+        } else if (strcmp(a, "--verbose") == 0) {
+            g_verbose_log = 1;
+        } else if (a[0] != '-' && !song_path) {
+            song_path = a;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!song_path) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (opt.jobs < 1) opt.jobs = 1;
+    if (opt.jobs > RENDER_MAX_JOBS) opt.jobs = RENDER_MAX_JOBS;
+    if (opt.preroll < 0) opt.preroll = 0;
+    if (opt.tail < 0.0) opt.tail = 0.0;
+
+    Song song;
+    if (load_song(&song, song_path) < 0) return 1;
+
+    memset(&g_stub_host, 0, sizeof(g_stub_host));
+    g_stub_host.api_version = MOVE_PLUGIN_API_VERSION;
+    g_stub_host.sample_rate = MOVE_SAMPLE_RATE;
+    g_stub_host.frames_per_block = MOVE_FRAMES_PER_BLOCK;
+    g_stub_host.log = render_log;
+
+    g_api = move_plugin_init_v2(&g_stub_host);
+    if (!g_api || g_api->api_version != MOVE_PLUGIN_API_VERSION_2) {
+        fprintf(stderr, "move_plugin_init_v2 failed\n");
+        return 1;
+    }
+
+    /* A probe instance loads the library and resolves the preset names */
+    void *probe = g_api->create_instance(opt.module_dir, NULL);
+    if (!probe) {
+        fprintf(stderr, "create_instance failed\n");
+        return 1;
+    }
+    char buf[64];
+    g_api->get_param(probe, "preset_count", buf, sizeof(buf));
+    int preset_count = atoi(buf);
+    if (preset_count <= 0) {
+        fprintf(stderr, "No presets in %s/presets\n", opt.module_dir);
+        return 1;
+    }
+    if (preset_count > RENDER_MAX_PRESETS) preset_count = RENDER_MAX_PRESETS;
+
+    int selected[RENDER_MAX_PRESETS];
+    memset(selected, 0, sizeof(selected));
+    for (int i = 0; i < preset_arg_count; i++) {
+        int idx = parse_preset(probe, preset_count, preset_args[i]);
+        if (idx == -2) {
+            fprintf(stderr, "Unknown preset: %s\n", preset_args[i]);
+            return 2;
+        }
+        for (int p = 0; p < preset_count; p++) {
+            if (idx == -1 || idx == p) selected[p] = 1;
+        }
+    }
+
+    RenderJob jobs[RENDER_MAX_PRESETS];
+    int job_count = 0;
+    char stem[128];
+    file_stem(stem, sizeof(stem), song_path);
+    sanitize(stem);
+    for (int p = 0; p < preset_count; p++) {
+        if (preset_arg_count && !selected[p]) continue;
+        RenderJob *job = &jobs[job_count++];
+        memset(job, 0, sizeof(*job));
+        job->preset = p;
+        snprintf(buf, sizeof(buf), "%d", p);
+        g_api->set_param(probe, "preset", buf);
+        g_api->get_param(probe, "preset_name", job->preset_name, sizeof(job->preset_name));
+        char name[64];
+        snprintf(name, sizeof(name), "%s", job->preset_name);
+        sanitize(name);
+        char wav_name[sizeof(job->wav_name)];
+        snprintf(wav_name, sizeof(wav_name), "%s-%02d_%s.wav", stem, p, name);
+        memcpy(job->wav_name, wav_name, sizeof(wav_name));
+        snprintf(job->wav_path, sizeof(job->wav_path), "%s/%s", opt.out_path, wav_name);
+    }
+    g_api->destroy_instance(probe);
+
+    /* A single render may name its file directly */
+    if (job_count == 1 && ends_with(opt.out_path, ".wav")) {
+        snprintf(jobs[0].wav_path, sizeof(jobs[0].wav_path), "%s", opt.out_path);
+    }
+
+    g_opt = &opt;
+    g_song = &song;
+    g_jobs = jobs;
+    g_job_count = job_count;
+    g_next_job = 0;
+
+    uint64_t t0 = now_ns();
+    int threads = opt.jobs < job_count ? opt.jobs : job_count;
+    pthread_t tids[RENDER_MAX_JOBS];
+    int started = 0;
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&tids[started], NULL, render_thread, NULL) == 0) started++;
+    }
+    render_thread(NULL);
+    for (int i = 0; i < started; i++) pthread_join(tids[i], NULL);
+    double seconds = (now_ns() - t0) * 1e-9;
+
+    int rc = 0;
+    uint64_t frames = 0;
+    for (int i = 0; i < job_count; i++) {
+        if (jobs[i].failed) {
+            fprintf(stderr, "Render of preset %d (%s) failed\n", jobs[i].preset,
+                    jobs[i].preset_name);
+            rc = 1;
+            continue;
+        }
+        printf("%016llx  %s\n", (unsigned long long)jobs[i].checksum, jobs[i].wav_name);
+        frames += jobs[i].frames;
+    }
+    fprintf(stderr, "%d preset(s), %d event(s), %.2f s of audio each, rendered in %.2f s "
+                    "(%.0fx real time)\n",
+            job_count, song.count, job_count ? (double)jobs[0].frames / MOVE_SAMPLE_RATE : 0.0,
+            seconds, seconds > 0.0 ? (double)frames / MOVE_SAMPLE_RATE / seconds : 0.0);
+
+    if (rc == 0 && opt.verify_path) {
+        int failures = verify(opt.verify_path, jobs, job_count);
+        if (failures < 0) {
+            fprintf(stderr, "Cannot read %s\n", opt.verify_path);
+            rc = 1;
+        } else if (failures > 0) {
+            fprintf(stderr, "%d render(s) differ from %s\n", failures, opt.verify_path);
+            rc = 1;
+        } else {
+            fprintf(stderr, "All %d render(s) match %s\n", job_count, opt.verify_path);
+        }
+    }
+    free(song.events);
+    return rc;
+}